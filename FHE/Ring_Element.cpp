@@ -151,6 +151,11 @@ void sub(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
 
 
 
+/* Products of elements in polynomial representation go through the FFT
+ * of FFT_Data whenever the modulus supports one (twop >= 0), otherwise
+ * they use mul_schoolbook(). Coefficients stay multi-limb modp values
+ * modulo a single prime; there is no RNS/NTT representation.
+ */
 void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
 {
   assert(a.FFTD);
@@ -178,10 +183,54 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
       for (int i=0; i<(*ans.FFTD).phi_m(); i++)
         ans.element.push_back(a.element[i].mul(b.element[i], a.FFTD->get_prD()));
     }
-  else if ((*a.FFTD).get_twop()!=0)
-    { // This is the case where m is not a power of two
+  else if ((*a.FFTD).get_twop()>=0)
+    { // FFT available, so change to evaluation and back, which
+      // costs O(phi(m) log(phi(m))) instead of O(phi(m)^2)
+      Ring_Element aa = a, bb = b;
+      aa.change_rep(evaluation);
+      bb.change_rep(evaluation);
+      aa *= bb;
+      aa.change_rep(polynomial);
+      ans = aa;
+    }
+  else
+    { // This is the case where m is not a power of two and there is no FFT
+      mul_schoolbook(ans, a, b);
+    }
+}
+
 
-      // Here we have to do a poly mult followed by a reduction
+void mul_schoolbook(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
+{
+  assert(a.FFTD);
+  if (a.rep!=polynomial or b.rep!=polynomial) { throw rep_mismatch(); }
+  if (a.FFTD!=b.FFTD) { throw pr_mismatch();  }
+  if (a.element.empty() or b.element.empty())
+    {
+      ans = Ring_Element(*a.FFTD, a.rep);
+      return;
+    }
+
+  if ((*a.FFTD).get_twop()==0)
+    { // m a power of two case, reduction modulo X^phi(m)+1
+      Ring_Element aa(*a.FFTD,a.rep);
+      aa.partial_assign(a);
+      modp temp;
+      for (int i=0; i<(*a.FFTD).phi_m(); i++)
+        { for (int j=0; j<(*a.FFTD).phi_m(); j++)
+            { Mul(temp,a.element[i],b.element[j],(*a.FFTD).get_prD());
+              int k=i+j;
+              if (k>=(*a.FFTD).phi_m())
+                 { k-=(*a.FFTD).phi_m();
+                   Negate(temp,temp,(*a.FFTD).get_prD());
+                 }
+              Add(aa.element[k],aa.element[k],temp,(*a.FFTD).get_prD());
+            }
+        }
+      ans=aa;
+    }
+  else
+    { // Here we have to do a poly mult followed by a reduction
       // We could be clever (e.g. use Karatsuba etc), but instead
       // we do the school book method followed by term re-writing
 
@@ -204,30 +253,6 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
      for (int i=0; i<(*ans.FFTD).phi_m(); i++)
        { ans.element[i]=aa[i]; }
     }
-  else if ((*a.FFTD).get_twop()==0)
-    { // m a power of two case
-      Ring_Element aa(*ans.FFTD,ans.rep);
-      aa.partial_assign(a);
-      modp temp;
-      cerr << "slow polynomial multiplication "
-              "(change representation to change this)..." << endl;
-      for (int i=0; i<(*ans.FFTD).phi_m(); i++)
-        { for (int j=0; j<(*ans.FFTD).phi_m(); j++)
-            { Mul(temp,a.element[i],b.element[j],(*a.FFTD).get_prD());
-              int k=i+j;
-              if (k>=(*ans.FFTD).phi_m())
-                 { k-=(*ans.FFTD).phi_m();
-                   Negate(temp,temp,(*a.FFTD).get_prD());
-                 }
-              Add(aa.element[k],aa.element[k],temp,(*a.FFTD).get_prD());
-            }
-          cerr << "\r" << i << "/" << ans.FFTD->phi_m();
-        }
-      cerr << endl;
-      ans=aa;
-    }
-  else
-    { throw not_implemented(); }
 }
 
 
@@ -84,6 +84,8 @@ class Ring_Element
   friend void sub(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b);
   friend void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b);
   friend void mul(Ring_Element& ans,const Ring_Element& a,const modp& b);
+  // O(phi(m)^2) product in polynomial representation, without the FFT
+  friend void mul_schoolbook(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b);
 
   Ring_Element mul_by_X_i(int i) const;
 
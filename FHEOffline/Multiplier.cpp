@@ -8,6 +8,9 @@
 #include "FHEOffline/PairwiseMachine.h"
 
 #include "Math/modp.hpp"
+#include "Tools/WaitQueue.h"
+
+#include <thread>
 
 template <class FD>
 Multiplier<FD>::Multiplier(int offset, PairwiseGenerator<FD>& generator) :
@@ -55,6 +58,84 @@ void Multiplier<FD>::multiply_and_add(Plaintext_<FD>& res,
     add(res, C, role);
 }
 
+template <class FD>
+void Multiplier<FD>::multiply_and_add(PlaintextVector<FD>& res,
+        const vector<Ciphertext>& enc_a, const AddableVector<Rq_Element>& b)
+{
+    size_t n = enc_a.size();
+    assert(res.size() >= n);
+    assert(b.size() >= n);
+
+    PRNG G;
+    G.ReSeed();
+    octetStream os[2];
+    Timer sending;
+    WaitQueue<size_t> to_send, sent;
+    exception_ptr error;
+
+    // one thread exchanges i in the background
+    // while this one masks i + 1 and decrypts i - 1
+    thread exchanger([this, &os, &sending, &to_send, &sent, &error]()
+    {
+        size_t i;
+        while (to_send.pop(i))
+        {
+            try
+            {
+                sending.start();
+                P.reverse_exchange(os[i % 2]);
+                sending.stop();
+            }
+            catch (...)
+            {
+                error = current_exception();
+            }
+            sent.push(i);
+        }
+    });
+
+    // also stop the exchanger if anything below throws
+    struct Joiner
+    {
+        WaitQueue<size_t>& queue;
+        thread& worker;
+        ~Joiner()
+        {
+            queue.stop();
+            worker.join();
+        }
+    } joiner{to_send, exchanger};
+
+    for (size_t i = 0; i <= n; i++)
+    {
+        if (i < n)
+        {
+            timers["Ciphertext multiplication"].start();
+            C.mul(enc_a[i], b[i]);
+            timers["Ciphertext multiplication"].stop();
+            os[i % 2].reset_write_head();
+            mask_product(res[i], C, os[i % 2], G);
+        }
+
+        if (i > 0)
+        {
+            size_t done;
+            sent.pop(done);
+            if (error)
+                rethrow_exception(error);
+        }
+
+        if (i < n)
+            to_send.push(i);
+
+        if (i > 0)
+            decrypt_product(res[i - 1], os[(i - 1) % 2]);
+    }
+
+    timers["Multiplied ciphertext sending"] += sending;
+    update_memory_usage();
+}
+
 template <class FD>
 void Multiplier<FD>::add(Plaintext_<FD>& res, const Ciphertext& c,
         OT_ROLE role, int)
@@ -65,14 +146,7 @@ void Multiplier<FD>::add(Plaintext_<FD>& res, const Ciphertext& c,
     {
         PRNG G;
         G.ReSeed();
-        timers["Mask randomization"].start();
-        product_share.randomize(G);
-        mask = c;
-        mask.rerandomize(other_pk);
-        timers["Mask randomization"].stop();
-        mask += product_share;
-        mask.pack(o);
-        res -= product_share;
+        mask_product(res, c, o, G);
     }
 
     timers["Multiplied ciphertext sending"].start();
@@ -85,14 +159,38 @@ void Multiplier<FD>::add(Plaintext_<FD>& res, const Ciphertext& c,
     timers["Multiplied ciphertext sending"].stop();
 
     if (role & RECEIVER)
-    {
-        timers["Decryption"].start();
-        C.unpack(o);
-        machine.sk.decrypt_any(product_share, C);
-        res += product_share;
-        timers["Decryption"].stop();
-    }
+        decrypt_product(res, o);
 
+    update_memory_usage();
+}
+
+template <class FD>
+void Multiplier<FD>::mask_product(Plaintext_<FD>& res, const Ciphertext& c,
+        octetStream& o, PRNG& G)
+{
+    timers["Mask randomization"].start();
+    product_share.randomize(G);
+    mask = c;
+    mask.rerandomize(other_pk);
+    timers["Mask randomization"].stop();
+    mask += product_share;
+    mask.pack(o);
+    res -= product_share;
+}
+
+template <class FD>
+void Multiplier<FD>::decrypt_product(Plaintext_<FD>& res, octetStream& o)
+{
+    timers["Decryption"].start();
+    C.unpack(o);
+    machine.sk.decrypt_any(product_share, C);
+    res += product_share;
+    timers["Decryption"].stop();
+}
+
+template <class FD>
+void Multiplier<FD>::update_memory_usage()
+{
     memory_usage.update("multiplied ciphertext", C.report_size(CAPACITY));
     memory_usage.update("mask ciphertext", mask.report_size(CAPACITY));
     memory_usage.update("product shares", product_share.report_size(CAPACITY));
@@ -38,6 +38,11 @@ class Multiplier
 
     octetStream o;
 
+    void mask_product(Plaintext_<FD>& res, const Ciphertext& c, octetStream& o,
+            PRNG& G);
+    void decrypt_product(Plaintext_<FD>& res, octetStream& o);
+    void update_memory_usage();
+
 public:
     Multiplier(int offset, PairwiseGenerator<FD>& generator);
     Multiplier(int offset, PairwiseMachine& machine, Player& P,
@@ -47,6 +52,9 @@ public:
             const Plaintext_<FD>& b);
     void multiply_and_add(Plaintext_<FD>& res, const Ciphertext& C,
             const Rq_Element& b, OT_ROLE role = BOTH);
+    // pipelined: exchanges one product while computing the neighbouring ones
+    void multiply_and_add(PlaintextVector<FD>& res,
+            const vector<Ciphertext>& C, const AddableVector<Rq_Element>& b);
     void add(Plaintext_<FD>& res, const Ciphertext& C, OT_ROLE role = BOTH,
             int n_summands = 1);
     void multiply_alpha_and_add(Plaintext_<FD>& res, const Rq_Element& b,
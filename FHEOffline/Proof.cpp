@@ -7,9 +7,39 @@
 #include "FHE/P2Data.h"
 #include "FHEOffline/EncCommit.h"
 #include "Math/Z2k.hpp"
+#include "Processor/BaseMachine.h"
 
 double Proof::dist = 0;
 
+namespace
+{
+ThreadQueues* proof_queues()
+{
+  if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
+    return &BaseMachine::s().queues;
+  else
+    return 0;
+}
+}
+
+size_t Proof::batch_size()
+{
+  auto queues = proof_queues();
+  return queues ? max(queues->size(), size_t(1)) : 1;
+}
+
+void Proof::run_batch(function<void(int, int)>& batch, int n)
+{
+  auto queues = proof_queues();
+  int start = 0;
+  ProofJob job(batch);
+  if (queues)
+    start = queues->distribute(job, n);
+  batch(start, n);
+  if (start > 0)
+    queues->wrap_up(job);
+}
+
 bigint Proof::slack(int slack, int sec, int phim)
 {
   switch (slack)
@@ -3,6 +3,7 @@
 
 #include <math.h>
 #include <vector>
+#include <functional>
 using namespace std;
 
 #include "Math/bigint.h"
@@ -134,6 +135,11 @@ class Proof
 
   bool check_bounds(T& z, X& t, int i) const;
 
+  // number of commitments handled at once, one per thread of the main thread
+  static size_t batch_size();
+  // run ``batch(begin, end)`` on ``[0, n)`` spread over those threads
+  static void run_batch(function<void(int, int)>& batch, int n);
+
   template<class T, class U>
   void apply_challenge(int i, T& output, const U& input, const FHE_PK& pk) const
   {
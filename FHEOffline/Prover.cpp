@@ -16,11 +16,13 @@ Prover<FD,U>::Prover(Proof& proof, const FD& FieldD) :
   s.resize(proof.V, proof.pk->get_params());
   y.resize(proof.V, FieldD);
 #ifdef LESS_ALLOC_MORE_MEM
-  t = s[0];
-  z = y[0];
+  t.resize(1);
+  z.resize(1);
+  t[0] = s[0];
+  z[0] = y[0];
   // extra limb to prevent reallocation
-  t.allocate_slots(bigint(1) << (proof.B_rand_length + 64));
-  z.allocate_slots(bigint(1) << (proof.B_plain_length + 64));
+  t[0].allocate_slots(bigint(1) << (proof.B_rand_length + 64));
+  z[0].allocate_slots(bigint(1) << (proof.B_plain_length + 64));
   s.allocate_slots(bigint(1) << proof.B_rand_length);
   y.allocate_slots(bigint(1) << proof.B_plain_length);
 #endif
@@ -44,22 +46,40 @@ void Prover<FD,U>::Stage_1(const Proof& P, octetStream& ciphertexts,
 //  ZZ bd=B_plain/(pr+1);
   PRNG G;
   G.ReSeed();
-  Random_Coins rc(pk.get_params());
-  Ciphertext ciphertext(pk.get_params());
   ciphertexts.store(V);
-  for (int i=0; i<V; i++)
+
+  // commit in batches of one per thread if the main thread has any available,
+  // each commitment with its own PRNG seeded from G
+  size_t batch_size = Proof::batch_size();
+  vector<PRNG> Gs(batch_size);
+  vector<Ciphertext> ciphertext(batch_size, Ciphertext(pk.get_params()));
+  for (int i=0; i<V; i+=batch_size)
     {
-//      AE.randomize(Diag,binary);
-//      rd=RandPoly(phim,bd<<1);
-//      y[i]=AE.plaintext()+pr*rd;
-      y[i].randomize(G, P.B_plain_length, P.get_diagonal());
-      if (P.get_diagonal())
-        assert(y[i].is_diagonal());
-      s[i].resize(3, P.phim);
-      s[i].generateUniform(G, P.B_rand_length);
-      rc.assign(s[i][0], s[i][1], s[i][2]);
-      pk.encrypt(ciphertext,y[i],rc);
-      ciphertext.pack(ciphertexts);
+      int n = min(size_t(V - i), batch_size);
+      for (int k = 0; k < n; k++)
+        Gs[k].SetSeed(G);
+
+      function<void(int, int)> commit_batch = [&](int begin, int end)
+        {
+          Random_Coins rc(pk.get_params());
+          for (int k = begin; k < end; k++)
+            {
+//              AE.randomize(Diag,binary);
+//              rd=RandPoly(phim,bd<<1);
+//              y[i]=AE.plaintext()+pr*rd;
+              y[i + k].randomize(Gs[k], P.B_plain_length, P.get_diagonal());
+              if (P.get_diagonal())
+                assert(y[i + k].is_diagonal());
+              s[i + k].resize(3, P.phim);
+              s[i + k].generateUniform(Gs[k], P.B_rand_length);
+              rc.assign(s[i + k][0], s[i + k][1], s[i + k][2]);
+              pk.encrypt(ciphertext[k], y[i + k], rc);
+            }
+        };
+      Proof::run_batch(commit_batch, n);
+
+      for (int k = 0; k < n; k++)
+        ciphertext[k].pack(ciphertexts);
     }
 }
 
@@ -77,24 +97,44 @@ bool Prover<FD,U>::Stage_2(Proof& P, octetStream& cleartexts,
 
   unsigned int i;
 #ifndef LESS_ALLOC_MORE_MEM
-  AddableVector<fixint<gfp::N_LIMBS>> z;
-  AddableMatrix<fixint<gfp::N_LIMBS>> t;
+  AddableVector<AddableVector<fixint<gfp::N_LIMBS>>> z;
+  AddableVector<AddableMatrix<fixint<gfp::N_LIMBS>>> t;
 #endif
   cleartexts.reset_write_head();
   cleartexts.store(P.V);
   if (P.get_diagonal())
     for (auto& xx : x)
       assert(xx.is_diagonal());
-  for (i=0; i<P.V; i++)
-    { z=y[i];
-      t=s[i];
-      P.apply_challenge(i, z, x, pk);
-      Check_Decoding(z, P.get_diagonal(), x[0].get_field());
-      P.apply_challenge(i, t, r, pk);
-      if (not P.check_bounds(z, t, i))
-          return false;
-      z.pack(cleartexts);
-      t.pack(cleartexts);
+
+  // respond in batches like the commitments
+  size_t batch_size = Proof::batch_size();
+  z.resize(batch_size);
+  t.resize(batch_size);
+  vector<char> in_bounds(batch_size);
+  for (i=0; i<P.V; i+=batch_size)
+    {
+      int n = min(size_t(P.V - i), batch_size);
+      function<void(int, int)> respond_batch = [&](int begin, int end)
+        {
+          for (int k = begin; k < end; k++)
+            {
+              z[k]=y[i + k];
+              t[k]=s[i + k];
+              P.apply_challenge(i + k, z[k], x, pk);
+              Check_Decoding(z[k], P.get_diagonal(), x[0].get_field());
+              P.apply_challenge(i + k, t[k], r, pk);
+              in_bounds[k] = P.check_bounds(z[k], t[k], i + k);
+            }
+        };
+      Proof::run_batch(respond_batch, n);
+
+      for (int k = 0; k < n; k++)
+        {
+          if (not in_bounds[k])
+            return false;
+          z[k].pack(cleartexts);
+          t[k].pack(cleartexts);
+        }
    }
 #ifndef LESS_ALLOC_MORE_MEM
   volatile_memory = t.report_size(CAPACITY) + z.report_size(CAPACITY);
@@ -389,9 +389,9 @@ template <class FD>
 void MultiEncCommit<FD>::add_ciphertexts(vector<Ciphertext>& ciphertexts,
         int offset)
 {
-    for (unsigned i = 0; i < this->proof.U; i++)
-        generator.multipliers[offset - 1]->multiply_and_add(generator.c.at(i),
-                ciphertexts.at(i), generator.b_mod_q.at(i));
+    assert(ciphertexts.size() == this->proof.U);
+    generator.multipliers[offset - 1]->multiply_and_add(generator.c,
+            ciphertexts, generator.b_mod_q);
 }
 
 template class SimpleEncCommitBase<gfp, FFT_Data, bigint>;
@@ -3,15 +3,19 @@
 #include "Math/Z2k.hpp"
 #include "Math/modp.hpp"
 
+#include <functional>
+
 template <class FD>
 Verifier<FD>::Verifier(Proof& proof, const FD& FieldD) :
     P(proof), FieldD(FieldD)
 {
 #ifdef LESS_ALLOC_MORE_MEM
-  z.resize(proof.phim);
-  z.allocate_slots(bigint(1) << proof.B_plain_length);
-  t.resize(3, proof.phim);
-  t.allocate_slots(bigint(1) << proof.B_rand_length);
+  z.resize(1);
+  t.resize(1);
+  z[0].resize(proof.phim);
+  z[0].allocate_slots(bigint(1) << proof.B_plain_length);
+  t[0].resize(3, proof.phim);
+  t[0].allocate_slots(bigint(1) << proof.B_rand_length);
 #endif
 }
 
@@ -61,6 +65,35 @@ bool Check_Decoding(const vector<Proof::bound_type>& AE, bool Diag, const P2Data
 
 
 
+template <class FD>
+const char* Verifier<FD>::check(int i, int k, Ciphertext& d1,
+    const AddableVector<Ciphertext>& c, const FHE_PK& pk)
+{
+  if (!P.check_bounds(z[k], t[k], i))
+    return "preimage out of bounds";
+  P.apply_challenge(i, d1, c, pk);
+  Random_Coins rc(pk.get_params());
+  rc.assign(t[k][0], t[k][1], t[k][2]);
+  Ciphertext d2(pk.get_params());
+  pk.encrypt(d2, z[k], rc);
+  if (!(d1 == d2))
+    {
+#ifdef VERBOSE
+      cout << "Fail Check 6 " << i << endl;
+#endif
+      return "ciphertexts don't match";
+    }
+  if (!Check_Decoding(z[k],P.get_diagonal(),FieldD))
+    {
+#ifdef VERBOSE
+      cout << "\tCheck : " << i << endl;
+#endif
+      return "cleartext isn't diagonal";
+    }
+  return 0;
+}
+
+
 template <class FD>
 void Verifier<FD>::Stage_2(
                           AddableVector<Ciphertext>& c,octetStream& ciphertexts,
@@ -73,39 +106,41 @@ void Verifier<FD>::Stage_2(
   if (c.size() != P.U)
     throw length_error("number of received ciphertexts incorrect");
 
-  // Now check the encryptions are correct
-  Ciphertext d1(pk.get_params()), d2(pk.get_params());
-  Random_Coins rc(pk.get_params());
   ciphertexts.get(V);
   if (V != P.V)
     throw length_error("number of received commitments incorrect");
   cleartexts.get(V);
   if (V != P.V)
     throw length_error("number of received cleartexts incorrect");
-  for (i=0; i<V; i++)
+
+  // Now check the encryptions are correct,
+  // in batches of one per thread if the main thread has any available
+  size_t batch_size = Proof::batch_size();
+  z.resize(batch_size);
+  t.resize(batch_size);
+  vector<Ciphertext> d1(batch_size, Ciphertext(pk.get_params()));
+  vector<const char*> errors(batch_size);
+
+  for (i=0; i<V; i+=batch_size)
     {
-      z.unpack(cleartexts);
-      t.unpack(cleartexts);
-      if (!P.check_bounds(z, t, i))
-        throw runtime_error("preimage out of bounds");
-      d1.unpack(ciphertexts);
-      P.apply_challenge(i, d1, c, pk);
-      rc.assign(t[0], t[1], t[2]);
-      pk.encrypt(d2,z,rc);
-      if (!(d1 == d2))
+      int n = min(size_t(V - i), batch_size);
+      for (int k = 0; k < n; k++)
         {
-#ifdef VERBOSE
-          cout << "Fail Check 6 " << i << endl;
-#endif
-          throw runtime_error("ciphertexts don't match");
+          z[k].unpack(cleartexts);
+          t[k].unpack(cleartexts);
+          d1[k].unpack(ciphertexts);
         }
-      if (!Check_Decoding(z,P.get_diagonal(),FieldD))
-         {
-#ifdef VERBOSE
-          cout << "\tCheck : " << i << endl;
-#endif
-           throw runtime_error("cleartext isn't diagonal");
-         }
+
+      function<void(int, int)> check_batch = [&](int begin, int end)
+        {
+          for (int k = begin; k < end; k++)
+            errors[k] = check(i + k, k, d1[k], c, pk);
+        };
+      Proof::run_batch(check_batch, n);
+
+      for (int k = 0; k < n; k++)
+        if (errors[k])
+          throw runtime_error(errors[k]);
     }
 }
 
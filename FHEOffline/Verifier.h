@@ -10,12 +10,17 @@ bool Check_Decoding(const vector<Proof::bound_type>& AE, bool Diag, FD& FieldD);
 template <class FD>
 class Verifier
 {
-  AddableVector<typename Proof::bound_type> z;
-  AddableMatrix<Int_Random_Coins::value_type::value_type> t;
+  // preimages of one batch
+  vector<AddableVector<typename Proof::bound_type>> z;
+  vector<AddableMatrix<Int_Random_Coins::value_type::value_type>> t;
 
   Proof& P;
   const FD& FieldD;
 
+  // reason for rejecting the i-th commitment (from batch slot k) or null
+  const char* check(int i, int k, Ciphertext& d1,
+      const AddableVector<Ciphertext>& c, const FHE_PK& pk);
+
 public:
   Verifier(Proof& proof, const FD& FieldD);
 
@@ -30,7 +35,13 @@ public:
   void NIZKPoK(AddableVector<Ciphertext>& c,octetStream& ciphertexts,octetStream& cleartexts,
                const FHE_PK& pk);
 
-  size_t report_size(ReportType type) { return z.report_size(type) + t.report_size(type); }
+  size_t report_size(ReportType type)
+  {
+    size_t res = 0;
+    for (size_t k = 0; k < z.size(); k++)
+      res += z[k].report_size(type) + t[k].report_size(type);
+    return res;
+  }
 };
 
 #endif
@@ -32,7 +32,8 @@ void BitAdder::add(vector<vector<GC::RmfeShare>>& res, const vector<vector<vecto
             if (T::expensive_triples)
             {
                 supplies[i] = &quintuples[i];
-                for (size_t j = 0; j < n_per_thread * summands.size(); j++)
+                for (size_t j = 0;
+                        j < n_per_thread * n_quintuples(summands.size()); j++)
                     quintuples[i].push_back(proc.DataF.get_quintuple(T::default_length));
 #ifdef VERBOSE_EDA
                 cerr << "supplied " << quintuples[i].size() << endl;
@@ -76,21 +77,50 @@ void BitAdder::add(vector<vector<GC::RmfeShare>>& res, const vector<vector<vecto
         fprintf(stderr, "got supply\n");
 #endif
         auto& s = *(vector<array<T, 5>>*) supply;
-        assert(s.size() == n_items * n_bits);
+        assert(s.size() == n_items * n_quintuples(n_bits));
         proc.DataF.push_quintuples(s);
     }
 
     assert (summands[0].size() == 2);
-
-    vector<T> carries(n_items);
-    vector<T> a(n_items), b(n_items);
-    auto& protocol = proc.protocol;
     for (int i = 0; i < n_bits; i++)
     {
         assert(summands[i].size() == 2);
         assert(summands[i][0].size() >= input_begin + n_items);
         assert(summands[i][1].size() >= input_begin + n_items);
+    }
+
+    if (OnlineOptions::singleton.rmfe_adder == "kogge-stone")
+        kogge_stone_add(res, summands, begin, n_items, proc, length,
+                input_begin);
+    else
+        ripple_add(res, summands, begin, n_items, proc, length, input_begin);
+}
+
+size_t BitAdder::n_quintuples(int n_bits)
+{
+    if (OnlineOptions::singleton.rmfe_adder != "kogge-stone")
+        return n_bits;
+
+    // generate bits, then combinations at each distance d
+    size_t res = n_bits;
+    for (int d = 1; d < n_bits; d *= 2)
+        res += (n_bits - d) + max(n_bits - 2 * d, 0);
+    return res;
+}
 
+void BitAdder::ripple_add(vector<vector<GC::RmfeShare>>& res,
+        const vector<vector<vector<GC::RmfeShare>>>& summands, size_t begin,
+        size_t n_items, SubProcessor<GC::RmfeShare>& proc, int length,
+        int input_begin)
+{
+    typedef GC::RmfeShare T;
+    int n_bits = summands.size();
+
+    vector<T> carries(n_items);
+    vector<T> a(n_items), b(n_items);
+    auto& protocol = proc.protocol;
+    for (int i = 0; i < n_bits; i++)
+    {
         for (size_t j = 0; j < n_items; j++)
         {
             a[j] = summands[i][0][input_begin + j];
@@ -112,5 +142,67 @@ void BitAdder::add(vector<vector<GC::RmfeShare>>& res, const vector<vector<vecto
     for (size_t j = 0; j < n_items; j++)
         res[begin + j][n_bits] = carries[j];
 }
+
+/**
+ * Parallel prefix adder with ``1 + ceil(log2(n_bits))`` rounds
+ * instead of ``n_bits``, at the cost of about ``log2(n_bits)`` times
+ * as many multiplications.
+ */
+void BitAdder::kogge_stone_add(vector<vector<GC::RmfeShare>>& res,
+        const vector<vector<vector<GC::RmfeShare>>>& summands, size_t begin,
+        size_t n_items, SubProcessor<GC::RmfeShare>& proc, int length,
+        int input_begin)
+{
+    typedef GC::RmfeShare T;
+    int n_bits = summands.size();
+    auto& protocol = proc.protocol;
+
+    // propagate and generate bits
+    vector<vector<T>> p(n_bits, vector<T>(n_items));
+    vector<vector<T>> g(n_bits, vector<T>(n_items));
+    protocol.init_mul();
+    for (int i = 0; i < n_bits; i++)
+        for (size_t j = 0; j < n_items; j++)
+        {
+            auto& a = summands[i][0][input_begin + j];
+            auto& b = summands[i][1][input_begin + j];
+            p[i][j] = a + b;
+            res[begin + j][i] = p[i][j];
+            protocol.prepare_mul(a, b, length);
+        }
+    protocol.exchange();
+    for (int i = 0; i < n_bits; i++)
+        for (size_t j = 0; j < n_items; j++)
+            g[i][j] = protocol.finalize_mul(length);
+
+    // afterwards, g[i] and p[i] cover bits i - 2d + 1 to i
+    // (or 0 to i for g[i]); p[i] is only needed further for i >= 2d
+    for (int d = 1; d < n_bits; d *= 2)
+    {
+        protocol.init_mul();
+        for (int i = d; i < n_bits; i++)
+            for (size_t j = 0; j < n_items; j++)
+            {
+                protocol.prepare_mul(p[i][j], g[i - d][j], length);
+                if (i >= 2 * d)
+                    protocol.prepare_mul(p[i][j], p[i - d][j], length);
+            }
+        protocol.exchange();
+        for (int i = d; i < n_bits; i++)
+            for (size_t j = 0; j < n_items; j++)
+            {
+                // generate and propagate are exclusive, so XOR is OR
+                g[i][j] += protocol.finalize_mul(length);
+                if (i >= 2 * d)
+                    p[i][j] = protocol.finalize_mul(length);
+            }
+    }
+
+    for (int i = 1; i < n_bits; i++)
+        for (size_t j = 0; j < n_items; j++)
+            res[begin + j][i] += g[i - 1][j];
+    for (size_t j = 0; j < n_items; j++)
+        res[begin + j][n_bits] = g[n_bits - 1][j];
+}
 #endif
 
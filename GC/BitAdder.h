@@ -42,6 +42,20 @@ public:
     void add(vector<vector<GC::RmfeShare>>& res, const vector<vector<vector<GC::RmfeShare>>>& summands,
             size_t begin, size_t end, SubProcessor<GC::RmfeShare>& proc, int length,
             int input_begin, const void* supply);
+
+    /// Number of quintuples per item for adding ``n_bits``-bit numbers
+    static size_t n_quintuples(int n_bits);
+
+private:
+    void ripple_add(vector<vector<GC::RmfeShare>>& res,
+            const vector<vector<vector<GC::RmfeShare>>>& summands,
+            size_t begin, size_t n_items, SubProcessor<GC::RmfeShare>& proc,
+            int length, int input_begin);
+
+    void kogge_stone_add(vector<vector<GC::RmfeShare>>& res,
+            const vector<vector<vector<GC::RmfeShare>>>& summands,
+            size_t begin, size_t n_items, SubProcessor<GC::RmfeShare>& proc,
+            int length, int input_begin);
 #endif
 
 };
@@ -58,6 +58,9 @@ public:
 
     void send_mine();
 
+    /// Sum of the next inputs from all parties, counterpart of ``add_from_all``
+    T finalize_sum(int n_bits = -1);
+
     T finalize_mine();
     void finalize_other(int player, T& target, octetStream& o, int n_bits = -1);
 };
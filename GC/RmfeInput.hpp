@@ -58,11 +58,7 @@ void RmfeInput<T>::add_mine(const BitVec& input, int n_bits)
         throw runtime_error("Cannot handle bits more than rmfe packing size");
     if (n_bits == -1)
         n_bits = T::default_length;
-    NTL::vec_GF2 ntl_input;
-    open_type encoded_input;
-    conv(ntl_input, input, n_bits);
-    pad(ntl_input, Gf2RMFE::s().k());
-    conv(encoded_input, Gf2RMFE::s().encode(ntl_input));
+    open_type encoded_input = bitvec_rmfe(input.mask(n_bits));
 
     add_mine(encoded_input, n_bits);
 }
@@ -83,6 +79,15 @@ void RmfeInput<T>::send_mine()
     P.send_all(this->os[P.my_num()]);
 }
 
+template<class T>
+T RmfeInput<T>::finalize_sum(int n_bits)
+{
+    T res;
+    for (int i = 0; i < P.num_players(); i++)
+        res += this->finalize(i, n_bits);
+    return res;
+}
+
 template<class T>
 T RmfeInput<T>::finalize_mine()
 {
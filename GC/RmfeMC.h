@@ -2,18 +2,122 @@
 #define GC_RMFE_MC_H_
 
 #include "Tools/debug.h"
-
+#include "Tools/Hash.h"
+#include "Tools/Subroutines.h"
+#include "Math/gf2n42.h"
+
+/**
+ * Opening with a deferred MAC check whose state does not grow with the
+ * number of opened values.
+ *
+ * Every opened batch is folded into a random linear combination as soon
+ * as its coefficients are known. The coefficients of a batch are seeded
+ * by a coin whose shares are committed to together with the batch and
+ * opened together with the next one, so no party knows them before
+ * fixing its shares of the batch and no extra round is needed. Only the
+ * last batch is kept until the next exchange or ``Check``, which opens
+ * its coin and then the combination. The batch is kept as GF(2^42)
+ * words, so that folding is two ``gf2n42::dot`` calls.
+ */
 template<class T>
 class RmfeMC : public MAC_Check_<T>
 {
+    typedef typename T::open_type open_type;
+    typedef typename T::mac_type mac_type;
+
+    // combinations of all folded values and MACs
+    mac_type val_sum, mac_sum;
+    bool folded;
+
+    // last batch waiting for its coin, and its coefficients
+    vector<uint64_t> pending_vals, pending_macs, chis;
+    bool pending;
+
+    // coin for the pending batch
+    octetStream my_coin, my_opening;
+    vector<octetStream> coin_comms;
+
+    void commit_coin(const Player& P, octetStream& os)
+    {
+        PRNG G;
+        G.ReSeed();
+        my_coin.reset_write_head();
+        G.get_octetStream(my_coin, SEED_SIZE);
+        Commitment commitment(P.my_num());
+        commitment.commit(my_coin);
+        my_opening = commitment.open;
+        os.concat(commitment.comm);
+    }
+
+    void receive_comms(const Player& P, vector<octetStream>& oss)
+    {
+        coin_comms.resize(P.num_players());
+        for (int j = 0; j < P.num_players(); j++)
+            if (j != P.my_num())
+                oss[j].consume(coin_comms[j], Hash::hash_length);
+    }
+
+    void open_coin(octetStream& os)
+    {
+        os.concat(my_coin);
+        os.concat(my_opening);
+    }
+
+    // check the opened coin and fold the pending batch
+    void fold(const Player& P, vector<octetStream>& oss)
+    {
+        octet seed[SEED_SIZE];
+        memcpy(seed, my_coin.get_data(), SEED_SIZE);
+        for (int j = 0; j < P.num_players(); j++)
+            if (j != P.my_num())
+            {
+                octetStream coin, opening;
+                oss[j].consume(coin, SEED_SIZE);
+                oss[j].consume(opening, SEED_SIZE);
+                Commitment(j).check(coin, coin_comms[j], opening);
+                for (int k = 0; k < SEED_SIZE; k++)
+                    seed[k] ^= coin.get_data()[k];
+            }
+
+        PRNG G;
+        G.SetSeed(seed);
+        size_t n = pending_vals.size();
+        assert(pending_macs.size() == n);
+        // same coefficients as mac_type::randomize()
+        chis.resize(n);
+        for (auto& chi : chis)
+            chi = G.get_word() & gf2n42::MASK;
+        val_sum += mac_type(gf2n_short(gf2n42::dot(chis.data(),
+                pending_vals.data(), n)));
+        mac_sum += mac_type(gf2n_short(gf2n42::dot(chis.data(),
+                pending_macs.data(), n)));
+
+        folded |= not pending_vals.empty();
+        pending_vals.clear();
+        pending_macs.clear();
+        pending = false;
+    }
+
 public:
     RmfeMC(const typename T::mac_key_type::Scalar& mac_key)
-    :  Tree_MAC_Check<T>(mac_key), MAC_Check_<T>(mac_key)
+    :  Tree_MAC_Check<T>(mac_key), MAC_Check_<T>(mac_key), folded(false),
+       pending(false)
     {
+        val_sum.assign_zero();
+        mac_sum.assign_zero();
+        // opened values are not kept
+        vector<open_type>().swap(this->vals);
     }
 
     virtual ~RmfeMC() {
-        print_general("Waiting for check", this->WaitingForCheck(), "RmfeMC destroy");
+#ifndef NO_SECURITY_CHECK
+        // folded values do not show up in WaitingForCheck()
+        if (folded or not pending_vals.empty())
+        {
+            cerr << endl << "SECURITY BUG: insufficient checking" << endl;
+            terminate();
+        }
+#endif
     }
 
     void prepare_open(const T& secret, int = -1)
@@ -23,48 +127,78 @@ public:
     }
 
     /**
-     * Insecure. Just open the values.
+     * Opens the values together with the coin of the previous batch
+     * and the commitment to the coin of this one.
     */
     void exchange(const Player& P)
     {
         vector<octetStream> oss;
         oss.resize(P.num_players());
         oss[P.my_num()].reset_write_head();
-        oss[P.my_num()].reserve(this->values.size() * T::open_type::size());
+        oss[P.my_num()].reserve(this->values.size() * T::open_type::size()
+                + 2 * SEED_SIZE + Hash::hash_length);
 
-        for (auto& x : this->values)
-            x.pack(oss[P.my_num()]);
-        oss[P.my_num()].append(0);
+        open_type::pack(oss[P.my_num()], this->values.data(),
+                this->values.size());
+        if (pending)
+            open_coin(oss[P.my_num()]);
+        commit_coin(P, oss[P.my_num()]);
 
         P.unchecked_broadcast(oss);
 
-        direct_add_openings<typename T::open_type>(this->values, P, oss);
-
-        this->AddToValues(this->values);
+        for (int j = 0; j < P.num_players(); j++)
+            if (j != P.my_num())
+                open_type::add(oss[j], this->values.data(),
+                        this->values.size());
+
+        if (pending)
+            fold(P, oss);
+        receive_comms(P, oss);
+
+        assert(this->macs.size() == this->values.size());
+        pending_vals.resize(this->values.size());
+        pending_macs.resize(this->macs.size());
+        for (size_t i = 0; i < this->values.size(); i++)
+        {
+            pending_vals[i] = this->values[i].get_word();
+            pending_macs[i] = this->macs[i].get_word();
+        }
+        this->macs.clear();
+        pending = true;
         this->popen_cnt += this->values.size();
-        this->CheckIfNeeded(P);
     }
 
     void Check (const Player& P) {
-        // [zico] Need to update
-
         assert(T::mac_type::invertible);
         check_field_size<typename T::mac_type>();
 
-        if (this->WaitingForCheck() == 0)
+        if (pending)
+        {
+            vector<octetStream> oss(P.num_players());
+            open_coin(oss[P.my_num()]);
+            P.Broadcast_Receive(oss);
+            fold(P, oss);
+        }
+
+        if (not folded)
             return;
 
-        auto& vals = this->vals;
-        auto& macs = this->macs;
-        auto& popen_cnt = this->popen_cnt;
-        assert(int(macs.size()) == popen_cnt);
-        assert(int(vals.size()) == popen_cnt);
         assert(this->coordinator);
-
-        this->vals.erase(this->vals.begin(), this->vals.begin() + this->popen_cnt);
-        this->macs.erase(this->macs.begin(), this->macs.begin() + this->popen_cnt);
-
-        this->popen_cnt=0;
+        vector<mac_type> tau(P.num_players());
+        tau[P.my_num()] = mac_sum - this->alphai * val_sum;
+        Commit_And_Open(tau, P, *this->coordinator);
+
+        mac_type t;
+        t.assign_zero();
+        for (auto& x : tau)
+            t += x;
+
+        val_sum.assign_zero();
+        mac_sum.assign_zero();
+        folded = false;
+        this->popen_cnt = 0;
+        if (not t.is_zero())
+            throw mac_fail();
     }
 
     RmfeMC<typename T::part_type>& get_part_MC()
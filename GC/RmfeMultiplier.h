@@ -35,7 +35,14 @@ public:
      * be equal to N.
     */
     void correlate(vector<BitMatrix>& output, const vector<BitMatrix>& senderInput, int n);
-};
+    /**
+     * OLE in GF(2^42) with the other party, using one OT per bit of ``x``:
+     * ``res[i][j]`` is this party's share of ``x[i] * y'[i][j] + x'[i] * y[i][j]``,
+     * where ``x'`` and ``y'`` are the inputs of the other party.
+     * Both products of ``x[i]`` share the choice bits and one correlation.
+    */
+    void multiply(vector<array<uint64_t, 2>>& res, const vector<uint64_t>& x,
+            const vector<array<uint64_t, 2>>& y);
 
 #ifdef BENCHMARK_MASCOT_APPROACH
 #else
@@ -2,6 +2,7 @@
 #define GC_RMFEMULTIPLIER_HPP_
 
 #include "GC/RmfeMultiplier.h"
+#include "Math/gf2n42.h"
 
 template<class T>
 void RmfeMultiplier<T>::after_correlation() {
@@ -29,7 +30,8 @@ RmfeMultiplier<T>::~RmfeMultiplier() {
 
 template<class T>
 void RmfeMultiplier<T>::multiply() {
-    // [zico] Multiplier is run in a separate thread, so we need to setup MFE again for the `thread_local` singleton.
+    // Multiplier is run in a separate thread, which only needs to point
+    // its `thread_local` singleton to the shared MFE instance.
     RmfeBeaver<T>::setup_mfe();
 
     OTMultiplier<T>::multiply();
@@ -224,4 +226,51 @@ void Fole<T>::correlate(vector<BitMatrix>& output, const vector<BitMatrix>& send
     delete[] packed_corr_block;
 }
 
+template<class T>
+void Fole<T>::multiply(vector<array<uint64_t, 2>>& res, const vector<uint64_t>& x,
+        const vector<array<uint64_t, 2>>& y) {
+    const int l = gf2n42::DEGREE;
+    size_t n = x.size();
+    assert(y.size() == n);
+    int64_t length = n * l;
+
+    // Gilboa: the k-th OT carries (y[i][0] * X^k, y[i][1] * X^k) for the k-th bit of x[i]
+    emp::block* data = new emp::block[length],
+        *corr = new emp::block[length];
+    bool* choices = new bool[length];
+    for (size_t i = 0; i < n; i++) {
+        uint64_t y0 = y[i][0], y1 = y[i][1];
+        for (int k = 0; k < l; k++) {
+            choices[i * l + k] = (x[i] >> k) & 1;
+            corr[i * l + k] = _mm_set_epi64x(y1, y0);
+            y0 = gf2n42::reduce(y0 << 1, 0);
+            y1 = gf2n42::reduce(y1 << 1, 0);
+        }
+    }
+
+    res.clear();
+    res.resize(n);
+    int emp_party = player->my_num() < player->other_player_num() ? emp::ALICE : emp::BOB;
+    // ALICE sends on `ot` and BOB on `ot_reversed`, one direction per cross product
+    for (int sender : {emp::ALICE, emp::BOB}) {
+        auto channel = sender == emp::ALICE ? ot : ot_reversed;
+        if (sender == emp_party)
+            channel->send_ot_cxm_cc(data, corr, length);
+        else
+            channel->recv_ot_cxm_cc(data, choices, length);
+        for (size_t i = 0; i < n; i++)
+            for (int k = 0; k < l; k++) {
+                res[i][0] ^= _mm_cvtsi128_si64(data[i * l + k]);
+                res[i][1] ^= _mm_extract_epi64(data[i * l + k], 1);
+            }
+    }
+    for (auto& r : res)
+        for (auto& z : r)
+            z &= gf2n42::MASK;
+
+    delete[] data;
+    delete[] corr;
+    delete[] choices;
+}
+
 #endif
\ No newline at end of file
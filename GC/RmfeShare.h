@@ -16,6 +16,9 @@
 #include "Tools/mpdz_ntl_types.h"
 #include "Tools/Exceptions.h"
 #include "Math/mfe.h"
+#include "Math/mfe64.h"
+#include "Math/rmfe_params.h"
+#include "Math/gf2n42.h"
 #include "Tools/debug.h"
 
 class gf2n_rmfe;
@@ -25,7 +28,7 @@ class bitvec_rmfe : public BitVec
 {
     typedef BitVec super;
 public:
-    static const int DEFAULT_LENGTH = 14;
+    static const int DEFAULT_LENGTH = DefaultRmfeParams::k;
 
     bitvec_rmfe() {
     }
@@ -93,7 +96,54 @@ public:
     // {
     // }
 
-    static const int DEFAULT_LENGTH = 42;
+    typedef DefaultRmfeParams params;
+
+    static const int DEFAULT_LENGTH = params::m;
+    static_assert(DEFAULT_LENGTH == gf2n42::DEGREE, "multiplication is for GF(2^42)");
+
+    using super::mul;
+    using super::operator*;
+    using super::operator*=;
+
+    /// Multiplication with the fixed modulus instead of the generic reduction
+    gf2n_rmfe& mul(const gf2n_rmfe& x, const gf2n_rmfe& y)
+    {
+        a = gf2n42::mul(x.a, y.a);
+        return *this;
+    }
+
+    gf2n_rmfe operator*(const gf2n_rmfe& x) const
+    {
+        gf2n_rmfe res;
+        res.mul(*this, x);
+        return res;
+    }
+
+    gf2n_rmfe& operator*=(const gf2n_rmfe& x)
+    {
+        return mul(*this, x);
+    }
+
+    /// Dense packing of contiguous elements, equivalent to ``pack()`` each
+    static void pack(octetStream& o, const gf2n_rmfe* x, size_t n)
+    {
+        static_assert(sizeof(gf2n_rmfe) == sizeof(uint64_t), "not a word");
+        gf2n42::pack(o.append(n * gf2n42::PACKED_SIZE), (const uint64_t*) x, n);
+    }
+
+    /// Equivalent to ``unpack()`` each
+    static void unpack(octetStream& o, gf2n_rmfe* x, size_t n)
+    {
+        gf2n42::unpack(
+                (uint64_t*) x, o.consume(n * gf2n42::PACKED_SIZE), n);
+    }
+
+    /// Equivalent to ``x[i] += o.get<gf2n_rmfe>()`` each
+    static void add(octetStream& o, gf2n_rmfe* x, size_t n)
+    {
+        gf2n42::unpack<true>(
+                (uint64_t*) x, o.consume(n * gf2n42::PACKED_SIZE), n);
+    }
 
     static int length()         { return n == 0 ? DEFAULT_LENGTH : n; }
     static int default_degree() { return DEFAULT_LENGTH; }
@@ -126,6 +176,7 @@ public:
     bool is_normal();
 
     static gf2n_rmfe random_preimage(const bitvec_rmfe& x);
+    static gf2n_rmfe random_preimage(const bitvec_rmfe& x, PRNG& G);
 };
 
 class bitvec_mfe : public BitVector
@@ -133,6 +184,7 @@ class bitvec_mfe : public BitVector
     typedef BitVector super;
 public:
     static const int DEFAULT_LENGTH = 225;
+    static_assert(DefaultRmfeParams::t <= DEFAULT_LENGTH, "MFE encoding too long");
 
     bitvec_mfe(): super(DEFAULT_LENGTH) {
     }
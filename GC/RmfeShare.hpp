@@ -12,18 +12,12 @@
 
 // NOTE: This constructor includes decoding.
 bitvec_rmfe::bitvec_rmfe(const gf2n_rmfe& encoded) {
-    NTL::GF2X ntl_tmp;
-    BitVec decoded;
-    conv(ntl_tmp, encoded);
-    conv(decoded, Gf2RMFE::s().decode(ntl_tmp));
-    super::operator=(decoded);
+    super::operator=(BitVec(CompositeGf2RMFE64::s().decode(encoded.get_word())));
 }
 
 // NOTE: This constructor includes encoding.
 gf2n_rmfe::gf2n_rmfe(const bitvec_rmfe& decoded) {
-    NTL::vec_GF2 ntl_tmp;
-    conv(ntl_tmp, decoded, bitvec_rmfe::DEFAULT_LENGTH);
-    conv(*this, Gf2RMFE::s().encode(ntl_tmp));
+    a = CompositeGf2RMFE64::s().encode(decoded.mask(bitvec_rmfe::DEFAULT_LENGTH).get());
 }
 
 gf2n_rmfe::gf2n_rmfe(const bitvec_mfe& encoded) {
@@ -54,7 +48,7 @@ void gf2n_rmfe::unpack(octetStream& o, int n) {
 }
 
 gf2n_rmfe gf2n_rmfe::tau(const gf2n_rmfe& x) {
-    return gf2n_rmfe(bitvec_rmfe(x));
+    return gf2n_short(CompositeGf2RMFE64::s().tau(x.get_word()));
 }
 
 bool gf2n_rmfe::is_normal() {
@@ -69,6 +63,11 @@ gf2n_rmfe gf2n_rmfe::random_preimage(const bitvec_rmfe& x) {
     return res;
 }
 
+gf2n_rmfe gf2n_rmfe::random_preimage(const bitvec_rmfe& x, PRNG& G) {
+    return gf2n_short(CompositeGf2RMFE64::s().random_preimage(
+        x.mask(bitvec_rmfe::DEFAULT_LENGTH).get(), G.get_word()));
+}
+
 template<>
 void Square<gf2n_rmfe>::to(gf2n_rmfe& result, false_type)
 {
@@ -13,6 +13,9 @@
 #include "Protocols/RmfeShareConverter.h"
 #include "TinyOT/tinyotshare.h"
 #include "TinyOT/tinyotinput.h"
+#include "TinierSecret.h"
+#include "TinyOTTripleProducer.h"
+#include "RmfeShareVector.h"
 
 
 namespace GC
@@ -25,7 +28,15 @@ class RmfeSharePrep : public PersonalPrep<T> {
     typename T::TripleGenerator* triple_generator;
     MascotParams params;
 
+    typedef TinierShare<gf2n_mac_key> tinier_type;
+
+    // two parties
     RmfeShareConverter<TinyOTShare>* tinyot2rmfe;
+    // more parties, from pairwise OT as in TinierSharePrep
+    RmfeShareConverter<tinier_type>* tinier2rmfe;
+
+    // Generates TinyOT triples for the next call of buffer_triples in the background
+    TinyOTTripleProducer<TinyOTShare>* tinyot_producer;
 
     // Put it as an instance variable instead of function local variable to save some RTTs.
     GlobalPRNG* shared_prng;
@@ -38,6 +49,27 @@ class RmfeSharePrep : public PersonalPrep<T> {
     using Preprocessing<T>::do_count;
     using BufferPrep<T>::quintuples;
 
+    // Splits into one batch per available thread, or runs `buffer_batch` here
+    template<int L, class Job>
+    void buffer_in_threads(vector<array<T, L>>& buffer,
+            void (RmfeSharePrep<T>::*buffer_batch)());
+    // Runs `buffer_batch` for batches[begin:end], keeping `buffer` as before
+    template<int L>
+    void buffer_batches(vector<vector<array<T, L>>>& batches, size_t begin,
+            size_t end, vector<array<T, L>>& buffer,
+            void (RmfeSharePrep<T>::*buffer_batch)());
+
+    void buffer_quintuple_batch();
+    // Converts and sacrifices bit triples from `converter`
+    template<class U>
+    void buffer_quintuples_from(RmfeShareConverter<U>& converter,
+            typename TinyOTTripleProducer<U>::Batch& batch);
+    void buffer_normal_batch();
+
+    // `n_subsets` random subsets of [0:n] as used by `RmfeShareVector::add_subset_sums`,
+    // the same for all parties
+    vector<uint64_t> random_subsets(size_t n_subsets, size_t n);
+
 public:
     RmfeSharePrep(DataPositions& usage, int input_player = PersonalPrep<T>::SECURE);
     RmfeSharePrep(SubProcessor<T>*, DataPositions& usage);
@@ -50,6 +82,9 @@ public:
     const int NORMAL_SACRIFICE = 40;
 
     void buffer_triples();
+    void buffer_quintuple_batches(vector<vector<array<T, 5>>>& batches,
+            size_t begin, size_t end);
+    void buffer_silent_quintuples();
     void buffer_inputs(int player);
 
     void buffer_personal_triples(size_t n, ThreadQueues* queues = 0) { throw runtime_error("no personal triples"); }
@@ -59,6 +94,8 @@ public:
     void buffer_personal_quintuples(vector<array<T, 5>>& quintuples, size_t begin, size_t end);
 
     void buffer_normals();
+    void buffer_normal_batches(vector<vector<array<T, 2>>>& batches,
+            size_t begin, size_t end);
 
     void set_protocol(typename T::Protocol& protocol);
 
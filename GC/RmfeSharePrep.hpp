@@ -13,6 +13,7 @@
 #include "Tools/debug.h"
 #include "TinyOT/tinyotprep.h"
 #include "Protocols/ReplicatedPrep.hpp"
+#include "Math/gf2n42.h"
 #ifdef DETAIL_BENCHMARK
 #include "Tools/performance.h"
 #endif
@@ -25,6 +26,8 @@ RmfeSharePrep<T>::RmfeSharePrep(DataPositions& usage, int input_player) :
         PersonalPrep<T>(usage, input_player),
         triple_generator(0),
         tinyot2rmfe(0),
+        tinier2rmfe(0),
+        tinyot_producer(0),
         shared_prng(0)
 {
     prng.SetSeed((const unsigned char*) "insecure");
@@ -39,10 +42,14 @@ RmfeSharePrep<T>::RmfeSharePrep(SubProcessor<T>*, DataPositions& usage) :
 template<class T>
 RmfeSharePrep<T>::~RmfeSharePrep()
 {
+    if (tinyot_producer)
+        delete tinyot_producer;
     if (triple_generator)
         delete triple_generator;
     if (tinyot2rmfe)
         delete tinyot2rmfe;
+    if (tinier2rmfe)
+        delete tinier2rmfe;
     if (shared_prng)
         delete shared_prng;
 }
@@ -69,9 +76,23 @@ void RmfeSharePrep<T>::set_protocol(typename T::Protocol& protocol)
 
     P = protocol.get_player();
 
-    int tinyot_batch_size = (triple_generator->nTriplesPerLoop + s) * T::default_length;
-    tinyot2rmfe = new RmfeShareConverter<TinyOTShare>(*P);
-    tinyot2rmfe->get_src_prep()->set_batch_size(tinyot_batch_size);
+    if (OnlineOptions::singleton.rmfe_prep == "tinyot")
+    {
+        if (P->num_players() == 2)
+        {
+            int tinyot_batch_size = (triple_generator->nTriplesPerLoop + s) * T::default_length;
+            tinyot2rmfe = new RmfeShareConverter<TinyOTShare>(*P);
+            tinyot2rmfe->get_src_prep()->set_batch_size(tinyot_batch_size);
+        }
+        else
+        {
+            auto& tinier = ShareThread<typename tinier_type::whole_type>::s();
+            tinier2rmfe = new RmfeShareConverter<tinier_type>(*P,
+                    tinier.MC->get_part_MC(),
+                    dynamic_cast<typename tinier_type::LivePrep&>(
+                            tinier.DataF.get_part()));
+        }
+    }
 
     shared_prng = new GlobalPRNG(*P);
 }
@@ -95,59 +116,144 @@ void RmfeSharePrep<T>::buffer_inputs(int player) {
 #endif
 }
 
+template<class T>
+template<int L, class Job>
+void RmfeSharePrep<T>::buffer_in_threads(vector<array<T, L>>& buffer,
+        void (RmfeSharePrep<T>::*buffer_batch)())
+{
+    ThreadQueues* queues = 0;
+    if (BaseMachine::has_singleton() and BaseMachine::thread_num == 0)
+        queues = &BaseMachine::s().queues;
+    // calls from within a distributed batch find no thread available
+    int n_available = queues ? queues->find_available() : 0;
+    if (n_available == 0)
+        return (this->*buffer_batch)();
+
+    // one batch per thread, each from the preprocessing of that thread
+    vector<vector<array<T, L>>> batches(n_available + 1);
+    Job job(&batches);
+    int start = queues->distribute_no_setup(job, batches.size());
+    buffer_batches(batches, start, batches.size(), buffer, buffer_batch);
+    if (start)
+        queues->wrap_up(job);
+    for (auto& batch : batches)
+        buffer.insert(buffer.end(), batch.begin(), batch.end());
+}
+
+template<class T>
+template<int L>
+void RmfeSharePrep<T>::buffer_batches(vector<vector<array<T, L>>>& batches,
+        size_t begin, size_t end, vector<array<T, L>>& buffer,
+        void (RmfeSharePrep<T>::*buffer_batch)())
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        size_t before = buffer.size();
+        (this->*buffer_batch)();
+        batches[i].assign(buffer.begin() + before, buffer.end());
+        buffer.resize(before);
+    }
+}
+
+template<class T>
+vector<uint64_t> RmfeSharePrep<T>::random_subsets(size_t n_subsets, size_t n)
+{
+    assert(shared_prng);
+    vector<uint64_t> res(n_subsets * DIV_CEIL(n, 64));
+    shared_prng->get_octets((octet*) res.data(), res.size() * sizeof(uint64_t));
+    return res;
+}
+
 template<class T>
 void RmfeSharePrep<T>::buffer_triples() {
+    buffer_in_threads<5, QuintupleJob>(quintuples,
+            &RmfeSharePrep<T>::buffer_quintuple_batch);
+}
+
+template<class T>
+void RmfeSharePrep<T>::buffer_quintuple_batches(
+        vector<vector<array<T, 5>>>& batches, size_t begin, size_t end) {
+    buffer_batches(batches, begin, end, quintuples,
+            &RmfeSharePrep<T>::buffer_quintuple_batch);
+}
+
+template<class T>
+void RmfeSharePrep<T>::buffer_quintuple_batch() {
 #ifdef BENCH_CRYPTO2022
     buffer_crypto2022_quintuples();
 #else
+    if (OnlineOptions::singleton.rmfe_prep == "silent")
+        return buffer_silent_quintuples();
+
 #ifdef DETAIL_BENCHMARK
     ThreadPerformance perf("Rmfe buffer_triples", this->P->total_comm().sent);
 #endif
 
-    auto n = triple_generator->nTriplesPerLoop + s;
-    auto tinyot_prep = tinyot2rmfe->get_src_prep();
+    int n = triple_generator->nTriplesPerLoop + s;
+    int l = T::default_length;
+
+    if (tinyot2rmfe)
+    {
+        // TinyOT triples are generated in the background, one batch ahead,
+        // while the current batch is converted and sacrificed
+        if (not tinyot_producer)
+            tinyot_producer = new TinyOTTripleProducer<TinyOTShare>(
+                    *tinyot2rmfe->get_src_prep(), n, l, tinyot2rmfe->n_masks());
+        auto batch = tinyot_producer->pop();
+        buffer_quintuples_from(*tinyot2rmfe, batch);
+    }
+    else if (tinier2rmfe)
+    {
+        // Tinier preprocessing uses the thread-local ShareThread,
+        // so the triples are generated here
+        typename TinyOTTripleProducer<tinier_type>::Batch batch;
+        TinyOTTripleProducer<tinier_type>::generate(batch,
+                *tinier2rmfe->get_src_prep(), n, l, tinier2rmfe->n_masks());
+        buffer_quintuples_from(*tinier2rmfe, batch);
+    }
+    else
+        throw runtime_error("no bit triples for RMFE quintuples, "
+                "use preprocessed quintuples (-F) instead");
 
+#ifdef DETAIL_BENCHMARK
+    perf.stop(this->P->total_comm().sent);
+    GlobalPerformance::s().add(perf);
+#endif
+#endif
+}
+
+template<class T>
+template<class U>
+void RmfeSharePrep<T>::buffer_quintuples_from(RmfeShareConverter<U>& converter,
+        typename TinyOTTripleProducer<U>::Batch& batch) {
+    int n = triple_generator->nTriplesPerLoop + s;
     int l = T::default_length;
+
     // triple storage arranged as: n x 3 x l
-    vector<TinyOTShare> tinyot_shares(n * 3 * l);
+    auto& bit_shares = batch.triples;
     // triple storage arranged as: n x 3
     vector<T> rmfe_shares;
 
-    // Generate tinyot triples
-    for(int i = 0; i < n; i++) {
-        for(int j = 0; j < l; j++) {
-            tinyot_prep->get_tinyot_triple(
-                tinyot_shares[i * 3 * l + j].MAC, 
-                tinyot_shares[i * 3 * l + j].KEY,
-                tinyot_shares[i * 3 * l + l + j].MAC, 
-                tinyot_shares[i * 3 * l + l + j].KEY,
-                tinyot_shares[i * 3 * l + 2 * l + j].MAC, 
-                tinyot_shares[i * 3 * l + 2 * l + j].KEY);
-        }
-    }
-
-    // Convert tinyot shares to rmfe shares
-    tinyot2rmfe->convert(rmfe_shares, tinyot_shares);
+    // Convert bit shares to rmfe shares
+    converter.convert(rmfe_shares, bit_shares, batch.masks);
     assert((int)rmfe_shares.size() == n * 3);
 
     // Construct random encoded inputs that decode to the same raw input
     auto& MC = ShareThread<typename T::whole_type>::s().MC->get_part_MC();
     typename T::Input input(MC, *this, *P);
     input.reset_all(*P);
+    SeededPRNG preimage_prng;
     for(int i = 0; i < n; i++) {
-        long raw_a = 0, raw_b = 0;
-        for(int j = 0; j < l; j++) {
-            raw_a ^= ((long) typename T::clear(tinyot_shares[i* 3 * l + j].get_bit(0).get_share()).get_bit(0)) << j;
-            raw_b ^= ((long) typename T::clear(tinyot_shares[i* 3 * l + l + j].get_bit(0).get_share()).get_bit(0)) << j;
-        }
-        input.add_from_all_encoded(T::open_type::random_preimage(typename T::clear(raw_a)));
-        input.add_from_all_encoded(T::open_type::random_preimage(typename T::clear(raw_b)));
+        long raw_a = converter.pack(&bit_shares[i * 3 * l]);
+        long raw_b = converter.pack(&bit_shares[i * 3 * l + l]);
+        input.add_from_all_encoded(T::open_type::random_preimage(typename T::clear(raw_a), preimage_prng));
+        input.add_from_all_encoded(T::open_type::random_preimage(typename T::clear(raw_b), preimage_prng));
     }
     input.exchange();
     vector<T> random_a(n), random_b(n);
     for(int i = 0; i < n; i++) {
-        random_a[i] = input.finalize(0) + input.finalize(1);
-        random_b[i] = input.finalize(0) + input.finalize(1);
+        random_a[i] = input.finalize_sum();
+        random_b[i] = input.finalize_sum();
     }
 
     // Sacrifice
@@ -167,15 +273,21 @@ void RmfeSharePrep<T>::buffer_triples() {
         y_prime[i] = rmfe_shares[(n-s+i) * 3];
         z[i] = random_b[n - s + i];
         z_prime[i] = rmfe_shares[(n-s+i) * 3 + 1];
-        for (int j = 0; j < n - s; j++) {
-            if (shared_prng->get_bit()) {
-                y[i] += random_a[j];
-                y_prime[i] += rmfe_shares[j*3];
-                z[i] += random_b[j];
-                z_prime[i] += rmfe_shares[j*3 + 1];
-            }
-        }
     }
+    RmfeShareVector<T> as, as_prime, bs, bs_prime;
+    for (auto x : {&as, &as_prime, &bs, &bs_prime})
+        x->reserve(n - s);
+    for (int j = 0; j < n - s; j++) {
+        as.push_back(random_a[j]);
+        as_prime.push_back(rmfe_shares[j*3]);
+        bs.push_back(random_b[j]);
+        bs_prime.push_back(rmfe_shares[j*3 + 1]);
+    }
+    auto subsets = random_subsets(s, n - s);
+    as.add_subset_sums(y, subsets.data(), s);
+    as_prime.add_subset_sums(y_prime, subsets.data(), s);
+    bs.add_subset_sums(z, subsets.data(), s);
+    bs_prime.add_subset_sums(z_prime, subsets.data(), s);
     // MC.POpen(y_open, y, *P);
     // MC.POpen(y_prime_open, y_prime, *P);
     // MC.POpen(z_open, z, *P);
@@ -195,12 +307,110 @@ void RmfeSharePrep<T>::buffer_triples() {
     }
 
     print_general("Generate RMFE quintuples", n-s);
+}
+
+/**
+ * Quintuples directly from OLE in GF(2^42) on the Ferret instances of the
+ * triple generator, without any bit triples:
+ * (a, tau(a)) and (b, tau(b)) are normal pairs, c = tau(a) * tau(b) is
+ * computed with pairwise OLE and authenticated as input, and every c is
+ * checked against c' = tau(a) * r for an independent random r.
+ *
+ * This is only secure against semi-honest adversaries. The bits of the
+ * shares of tau(a) are used as OT choice bits without any protection
+ * against selective failure: a wrong correlation for bit k makes the
+ * sacrifice fail exactly if that bit is one. tau is only GF(2)-linear,
+ * so a MASCOT-style combination of several inputs would need coefficients
+ * in GF(2) and hence about as many extra inputs as the security parameter.
+ * The mode is therefore only available with INSECURE.
+ */
+template<class T>
+void RmfeSharePrep<T>::buffer_silent_quintuples() {
+#ifdef DETAIL_BENCHMARK
+    ThreadPerformance perf("Rmfe buffer_silent_quintuples", this->P->total_comm().sent);
+#endif
+
+    typedef typename T::open_type U;
+    auto& party = ShareThread<typename T::whole_type>::s();
+    auto& P = *party.P;
+    auto MC = T::new_mc(party.MC->get_alphai());
+    typename T::Input input(*MC, *this, P);
+
+    int n = triple_generator->nTriplesPerLoop;
+    vector<array<T, 2>> as(n), bs(n);
+    for (int i = 0; i < n; i++) {
+        as[i] = this->get_normal_no_count();
+        bs[i] = this->get_normal_no_count();
+    }
+
+    // Step 1: random r, fixed before the multiplication
+    SeededPRNG G;
+    input.reset_all(P);
+    for (int i = 0; i < n; i++)
+        input.add_from_all_encoded(G.get<U>());
+    input.exchange();
+    vector<T> rs(n);
+    for (int i = 0; i < n; i++)
+        rs[i] = input.finalize_sum();
+
+    // Step 2: tau(a) * tau(b) and tau(a) * r, local products plus OLE with everyone else
+    vector<uint64_t> x(n);
+    vector<array<uint64_t, 2>> y(n), products(n), cross;
+    for (int i = 0; i < n; i++) {
+        x[i] = as[i][1].get_share().get_word();
+        y[i] = {{bs[i][1].get_share().get_word(), rs[i].get_share().get_word()}};
+        for (int j = 0; j < 2; j++)
+            products[i][j] = gf2n42::mul(x[i], y[i][j]);
+    }
+    // in order of the other party, which avoids waiting in circles
+    for (auto multiplier : triple_generator->ot_multipliers) {
+        multiplier->auth_ot_ext.multiply(cross, x, y);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < 2; j++)
+                products[i][j] ^= cross[i][j];
+    }
+
+    input.reset_all(P);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < 2; j++)
+            input.add_from_all_encoded(U(gf2n_short(products[i][j])));
+    input.exchange();
+    vector<T> cs(n), c_primes(n);
+    for (int i = 0; i < n; i++) {
+        cs[i] = input.finalize_sum();
+        c_primes[i] = input.finalize_sum();
+    }
+
+    // Step 3: sacrifice with challenges chosen after all products are fixed
+    GlobalPRNG challenge_prng(P);
+    vector<U> ts(n);
+    vector<T> rhos(n);
+    for (int i = 0; i < n; i++) {
+        ts[i] = challenge_prng.get<U>();
+        rhos[i] = ts[i] * bs[i][1] - rs[i];
+    }
+    vector<U> rhos_open;
+    MC->POpen(rhos_open, rhos, P);
+    vector<T> checks(n);
+    for (int i = 0; i < n; i++)
+        checks[i] = ts[i] * cs[i] - c_primes[i] - rhos_open[i] * as[i][1];
+    vector<U> checks_open;
+    MC->POpen(checks_open, checks, P);
+    for (int i = 0; i < n; i++)
+        if (not checks_open[i].is_zero())
+            throw runtime_error("Inconsistency found for [c] share");
+    MC->Check(P);
+    delete MC;
+
+    for (int i = 0; i < n; i++)
+        this->quintuples.push_back({{as[i][0], bs[i][0], cs[i], as[i][1], bs[i][1]}});
+
+    print_general("Generate silent RMFE quintuples", n);
 
 #ifdef DETAIL_BENCHMARK
     perf.stop(this->P->total_comm().sent);
     GlobalPerformance::s().add(perf);
 #endif
-#endif
 }
 
 template<class T>
@@ -315,6 +525,19 @@ void RmfeSharePrep<T>::buffer_personal_quintuples(vector<array<T, 5>>& quintuple
 
 template<class T>
 void RmfeSharePrep<T>::buffer_normals() {
+    buffer_in_threads<2, NormalJob>(this->normals,
+            &RmfeSharePrep<T>::buffer_normal_batch);
+}
+
+template<class T>
+void RmfeSharePrep<T>::buffer_normal_batches(
+        vector<vector<array<T, 2>>>& batches, size_t begin, size_t end) {
+    buffer_batches(batches, begin, end, this->normals,
+            &RmfeSharePrep<T>::buffer_normal_batch);
+}
+
+template<class T>
+void RmfeSharePrep<T>::buffer_normal_batch() {
 #ifdef DETAIL_BENCHMARK
     ThreadPerformance perf("Rmfe buffer_normals", P->total_comm().sent);
 #endif
@@ -341,8 +564,8 @@ void RmfeSharePrep<T>::buffer_normals() {
     input.exchange();
 
     for(int i = 0; i < n; i++) {
-        randoms[i] = input.finalize(0) + input.finalize(1);
-        normals[i] = input.finalize(0) + input.finalize(1);
+        randoms[i] = input.finalize_sum();
+        normals[i] = input.finalize_sum();
     }
 
     // Step 2: Sacrifice
@@ -351,13 +574,15 @@ void RmfeSharePrep<T>::buffer_normals() {
     for (int i = 0; i < NORMAL_SACRIFICE; i++) {
         b[i] = randoms[u + i];
         c[i] = normals[u + i];
-        for (int j = 0; j < u; j++) {
-            if (shared_prng->get_bit()) {
-                b[i] += randoms[j];
-                c[i] += normals[j];
-            }
-        }
     }
+    RmfeShareVector<T> bs, cs;
+    for (int j = 0; j < u; j++) {
+        bs.push_back(randoms[j]);
+        cs.push_back(normals[j]);
+    }
+    auto subsets = random_subsets(NORMAL_SACRIFICE, u);
+    bs.add_subset_sums(b.data(), subsets.data(), NORMAL_SACRIFICE);
+    cs.add_subset_sums(c.data(), subsets.data(), NORMAL_SACRIFICE);
     vector<typename T::open_type> b_opened;
     vector<typename T::open_type> c_opened;
     MC->POpen(b_opened, b, P);
@@ -435,7 +660,7 @@ void RmfeSharePrep<T>::buffer_crypto2022_quintuples() {
     input.exchange();
     vector<T> c_secrets(N);
     for(int i = 0; i < N; i++) {
-        c_secrets[i] = input.finalize(0) + input.finalize(1);
+        c_secrets[i] = input.finalize_sum();
     }
 
     // 3. Cut and choose
@@ -556,13 +781,19 @@ void RmfeSharePrep<T>::get_input_no_count(T& r_share, typename T::open_type& r ,
     typedef typename T::mac_type W;
 
     r.randomize(prng);
-    
-    array<U, 2> value_shares;
-    array<W, 2> mac_shares;
-    value_shares[0].randomize(prng);
-    value_shares[1] = r - value_shares[0];
-    mac_shares[0].randomize(prng);
-    mac_shares[1] = r * revealed_key - mac_shares[0];
+
+    // all parties draw the same shares, the last one fixes the sums
+    int n = P->num_players();
+    vector<U> value_shares(n);
+    vector<W> mac_shares(n);
+    value_shares[n - 1] = r;
+    mac_shares[n - 1] = r * revealed_key;
+    for (int i = 0; i < n - 1; i++) {
+        value_shares[i].randomize(prng);
+        mac_shares[i].randomize(prng);
+        value_shares[n - 1] -= value_shares[i];
+        mac_shares[n - 1] -= mac_shares[i];
+    }
 
     // `player` denotes the input's owner, but here we should use the share's owner
     r_share = {value_shares[P->my_num()], mac_shares[P->my_num()]};
@@ -573,29 +804,36 @@ void RmfeSharePrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c) {
     typedef typename T::raw_type V;
     typedef typename T::open_type U;
     typedef typename T::mac_type W;
-    array<array<V, 3>, 2> raw_triples;
-    raw_triples[0][0].randomize(prng, T::default_length);
-    raw_triples[0][1].randomize(prng, T::default_length);
-    raw_triples[0][2].randomize(prng, T::default_length);
-    raw_triples[1][0].randomize(prng, T::default_length);
-    raw_triples[1][1].randomize(prng, T::default_length);
-    raw_triples[1][2] = 
-        V(raw_triples[0][0] + raw_triples[1][0]) * 
-        V(raw_triples[0][1] + raw_triples[1][1]) - 
-        raw_triples[0][2];
-
-    array<array<U, 3>, 2> plain_triples;
-    for (int i = 0; i < 2; i++)
-        for (int j = 0; j < 3; j++)
+    int n = P->num_players();
+    vector<array<V, 3>> raw_triples(n);
+    array<V, 3> sums;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < 3; j++) {
+            if (i < n - 1 or j < 2)
+                raw_triples[i][j].randomize(prng, T::default_length);
+            if (j < 2)
+                sums[j] = i ? V(sums[j] + raw_triples[i][j]) : raw_triples[i][j];
+        }
+    raw_triples[n - 1][2] = V(sums[0] * sums[1]);
+    for (int i = 0; i < n - 1; i++)
+        raw_triples[n - 1][2] = V(raw_triples[n - 1][2] - raw_triples[i][2]);
+
+    vector<array<U, 3>> plain_triples(n);
+    array<U, 3> plain_sums;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < 3; j++) {
             plain_triples[i][j] = U(raw_triples[i][j]);
-    
-    array<array<W, 3>, 2> mac_triples;
-    mac_triples[0][0].randomize(prng);
-    mac_triples[0][1].randomize(prng);
-    mac_triples[0][2].randomize(prng);
-    mac_triples[1][0] = U(plain_triples[0][0] + plain_triples[1][0]) * revealed_key - mac_triples[0][0];
-    mac_triples[1][1] = U(plain_triples[0][1] + plain_triples[1][1]) * revealed_key - mac_triples[0][1];
-    mac_triples[1][2] = U(plain_triples[0][2] + plain_triples[1][2]) * revealed_key - mac_triples[0][2];
+            plain_sums[j] += plain_triples[i][j];
+        }
+
+    vector<array<W, 3>> mac_triples(n);
+    for (int j = 0; j < 3; j++) {
+        mac_triples[n - 1][j] = plain_sums[j] * revealed_key;
+        for (int i = 0; i < n - 1; i++) {
+            mac_triples[i][j].randomize(prng);
+            mac_triples[n - 1][j] -= mac_triples[i][j];
+        }
+    }
 
     int i = P->my_num();
     a = {plain_triples[i][0], mac_triples[i][0]};
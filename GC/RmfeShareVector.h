@@ -0,0 +1,116 @@
+/*
+ * RmfeShareVector.h
+ *
+ */
+
+#ifndef GC_RMFESHAREVECTOR_H_
+#define GC_RMFESHAREVECTOR_H_
+
+#include <vector>
+#include <algorithm>
+#include <assert.h>
+
+#include "OT/BitMatrix.h"
+#include "Math/gf2n42.h"
+#include "Tools/int.h"
+
+namespace GC
+{
+
+/**
+ * Vector of RMFE shares stored as structure of arrays, that is, one
+ * 64-byte aligned lane of share words and one of MAC words. Batches can
+ * then be handed to the ``gf2n42`` kernels without gathering the words
+ * from ``Share_`` objects first.
+ */
+template<class T>
+class RmfeShareVector
+{
+    typedef std::vector<uint64_t, aligned_allocator<uint64_t, 64>> lane_type;
+
+    lane_type shares, macs;
+
+public:
+    size_t size() const
+    {
+        return shares.size();
+    }
+
+    bool empty() const
+    {
+        return shares.empty();
+    }
+
+    void clear()
+    {
+        shares.clear();
+        macs.clear();
+    }
+
+    void reserve(size_t n)
+    {
+        shares.reserve(n);
+        macs.reserve(n);
+    }
+
+    void push_back(const T& x)
+    {
+        shares.push_back(x.get_share().get_word());
+        macs.push_back(x.get_mac().get_word());
+    }
+
+    T operator[](size_t i) const
+    {
+        T res;
+        res.set_share(gf2n_short(shares[i]));
+        res.set_mac(gf2n_short(macs[i]));
+        return res;
+    }
+
+    uint64_t* share_lane() { return shares.data(); }
+    uint64_t* mac_lane() { return macs.data(); }
+    const uint64_t* share_lane() const { return shares.data(); }
+    const uint64_t* mac_lane() const { return macs.data(); }
+
+    /**
+     * ``res[i] += sum_j this[j]`` over the ``j`` in subset ``i``, where
+     * subset ``i`` is given by the bits of ``DIV_CEIL(size(), 64)`` words
+     * starting at ``subsets[i * DIV_CEIL(size(), 64)]``. The elements are
+     * processed in blocks that stay in cache for all subsets, and the
+     * selection is done by masking instead of branching.
+     */
+    void add_subset_sums(T* res, const uint64_t* subsets, size_t n_subsets) const
+    {
+        const size_t block_size = 1 << 12;
+        size_t n_words = DIV_CEIL(size(), 64);
+        std::vector<uint64_t> sum_shares(n_subsets), sum_macs(n_subsets);
+        for (size_t begin = 0; begin < size(); begin += block_size)
+        {
+            size_t end = std::min(size(), begin + block_size);
+            for (size_t i = 0; i < n_subsets; i++)
+            {
+                const uint64_t* subset = subsets + i * n_words;
+                uint64_t share = 0, mac = 0;
+                for (size_t j = begin; j < end; j++)
+                {
+                    uint64_t mask = -((subset[j / 64] >> (j % 64)) & 1);
+                    share ^= shares[j] & mask;
+                    mac ^= macs[j] & mask;
+                }
+                sum_shares[i] ^= share;
+                sum_macs[i] ^= mac;
+            }
+        }
+        for (size_t i = 0; i < n_subsets; i++)
+        {
+            T sum;
+            sum.set_share(gf2n_short(sum_shares[i]));
+            sum.set_mac(gf2n_short(sum_macs[i]));
+            res[i] += sum;
+        }
+    }
+};
+
+} /* namespace GC */
+
+#endif /* GC_RMFESHAREVECTOR_H_ */
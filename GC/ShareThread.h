@@ -45,6 +45,12 @@ public:
         const vector<int>& args, bool repeat);
     void check_buffering_and_(int& ii, int& jj, int i, int j, 
         Processor<T>& processor, const vector<int>& args);
+    void check_pipelined_and_(int& ii, int& jj, int& fi, int& fj, int i,
+        int j, Processor<T>& processor, const vector<int>& args);
+    void finalize_ands_(Processor<T>& processor, const vector<int>& args,
+        int ii, int jj, int i, int j);
+    void finalize_and_(Processor<T>& processor, int n_bits, int out,
+        int begin, int end);
         
     void andrsvec(Processor<T>& processor, const vector<int>& args);
     void xors(Processor<T>& processor, const vector<int>& args);
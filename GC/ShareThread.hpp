@@ -122,68 +122,92 @@ void ShareThread<T>::and_(Processor<T>& processor,
     for (size_t i = 0; i < args.size(); i += 4)
     {
         int n_bits = args[i];
-        int out = args[i + 1];
-        for (int j = 0; j < DIV_CEIL(n_bits, T::default_length); j++)
-        {
-            int n = min(T::default_length, n_bits - j * T::default_length);
-            auto& res = processor.S[out + j];
-            protocol->finalize_mult(res, n);
-            res.mask(res, n);
-        }
+        finalize_and_(processor, n_bits, args[i + 1], 0,
+                DIV_CEIL(n_bits, T::default_length));
     }
 }
 
+/**
+ * Finalize chunks ``[begin, end)`` of an AND with ``n_bits`` bits,
+ * handing all full-width chunks to the protocol in one go.
+ */
+template<class T>
+void ShareThread<T>::finalize_and_(Processor<T>& processor, int n_bits,
+        int out, int begin, int end)
+{
+    typename T::Protocol& protocol = *(this->protocol);
+    int full = min(end, n_bits / T::default_length);
+    if (begin < full)
+        protocol.finalize_muls(&processor.S[out + begin], full - begin,
+                T::default_length);
+    for (int j = max(begin, full); j < end; j++)
+        protocol.finalize_mult(processor.S[out + j],
+                n_bits - j * T::default_length);
+    for (int j = begin; j < end; j++)
+    {
+        int n = min(T::default_length, n_bits - j * T::default_length);
+        auto& res = processor.S[out + j];
+        res.mask(res, n);
+    }
+}
+
+/**
+ * Finalize the ANDs from chunk ``jj`` of ``args[ii]`` up to, but
+ * excluding, chunk ``j`` of ``args[i]``.
+ */
+template<class T>
+void ShareThread<T>::finalize_ands_(Processor<T>& processor,
+        const vector<int>& args, int ii, int jj, int i, int j)
+{
+    if (ii == i) {
+        finalize_and_(processor, args[ii], args[ii + 1], jj, j);
+        return;
+    }
+    finalize_and_(processor, args[ii], args[ii + 1], jj,
+            DIV_CEIL(args[ii], T::default_length));
+    for (ii += 4; ii < i; ii += 4)
+        finalize_and_(processor, args[ii], args[ii + 1], 0,
+                DIV_CEIL(args[ii], T::default_length));
+    finalize_and_(processor, args[i], args[i + 1], 0, j);
+}
+
 template<class T>
 void ShareThread<T>::check_buffering_and_(int& ii, int& jj, int i, int j, 
     Processor<T>& processor, const vector<int>& args) {
     typename T::Protocol& protocol = *(this->protocol);
     if (protocol.get_buffer_size() >= protocol.buffer_size_per_round()) {
         protocol.exchange();
-        int ii_ = ii, jj_ = jj;
-        if (ii_ == i) {
-            int n_bits = args[ii_];
-            int out = args[ii_ + 1];
-            for (; jj_ <= j; jj_++) {
-                int n = min(T::default_length, n_bits - jj_ * T::default_length);
-                auto& res = processor.S[out + jj_];
-                protocol.finalize_mult(res, n);
-                res.mask(res, n);
-            }
-        }
-        else {
-            int n_bits = args[ii_];
-            int out = args[ii_ + 1];
-            for (; jj_ < DIV_CEIL(n_bits, T::default_length); jj_++) {
-                int n = min(T::default_length, n_bits - jj_ * T::default_length);
-                auto& res = processor.S[out + jj_];
-                protocol.finalize_mult(res, n);
-                res.mask(res, n);
-            }
-            for (ii_ += 4; ii_ < i; ii_ += 4) {
-                int n_bits = args[ii_];
-                int out = args[ii_ + 1];
-                for (jj_ = 0; jj_ < DIV_CEIL(n_bits, T::default_length); jj_++) {
-                    int n = min(T::default_length, n_bits - jj_ * T::default_length);
-                    auto& res = processor.S[out + jj_];
-                    protocol.finalize_mult(res, n);
-                    res.mask(res, n);
-                }
-            }
-            n_bits = args[ii_];
-            out = args[ii_ + 1];
-            for (jj_ = 0; jj_ <= j; jj_++) {
-                int n = min(T::default_length, n_bits - jj_ * T::default_length);
-                auto& res = processor.S[out + jj_];
-                protocol.finalize_mult(res, n);
-                res.mask(res, n);
-            }
-        }
+        finalize_ands_(processor, args, ii, jj, i, j + 1);
         protocol.init_mul();
         ii = i;
         jj = j + 1;
     }
 }
 
+/**
+ * Like ``check_buffering_and_``, but the full round is only started,
+ * and the round started before is finalized while it is in flight.
+ * ``(fi, fj)`` is the end of the round in flight, ``fi < 0`` if none.
+ */
+template<class T>
+void ShareThread<T>::check_pipelined_and_(int& ii, int& jj, int& fi, int& fj,
+        int i, int j, Processor<T>& processor, const vector<int>& args) {
+    typename T::Protocol& protocol = *(this->protocol);
+    if (protocol.get_buffer_size() >= protocol.buffer_size_per_round()) {
+        bool flying = fi >= 0;
+        if (flying)
+            protocol.stop_exchange();
+        protocol.start_exchange();
+        if (flying) {
+            finalize_ands_(processor, args, ii, jj, fi, fj);
+            ii = fi;
+            jj = fj;
+        }
+        fi = i;
+        fj = j + 1;
+    }
+}
+
 template<class T>
 void ShareThread<T>::buffering_and_(Processor<T>& processor,
         const vector<int>& args, bool repeat)
@@ -192,6 +216,8 @@ void ShareThread<T>::buffering_and_(Processor<T>& processor,
     processor.check_args(args, 4);
 
     int ii = 0, jj = 0;
+    int fi = -1, fj = 0;
+    bool pipelined = protocol->pipelined_exchange();
     protocol->init_mul();
     T x_ext, y_ext;
     for (size_t i = 0; i < args.size(); i += 4)
@@ -209,29 +235,37 @@ void ShareThread<T>::buffering_and_(Processor<T>& processor,
             processor.S[left + j].mask(x_ext, n);
             protocol->prepare_mult(x_ext, y_ext, n, repeat);
 
-            check_buffering_and_(ii, jj, i, j, processor, args);
+            if (pipelined)
+                check_pipelined_and_(ii, jj, fi, fj, i, j, processor, args);
+            else
+                check_buffering_and_(ii, jj, i, j, processor, args);
         }
     }
 
-    protocol->exchange();
+    if (pipelined)
+    {
+        if (fi >= 0)
+        {
+            protocol->stop_exchange();
+            protocol->start_exchange();
+            finalize_ands_(processor, args, ii, jj, fi, fj);
+            ii = fi;
+            jj = fj;
+        }
+        else
+            protocol->start_exchange();
+        protocol->stop_exchange();
+    }
+    else
+        protocol->exchange();
 
     int n_bits = args[ii];
-    int out = args[ii + 1];
-    for (; jj < DIV_CEIL(n_bits, T::default_length); jj++) {
-        int n = min(T::default_length, n_bits - jj * T::default_length);
-        auto& res = processor.S[out + jj];
-        protocol->finalize_mult(res, n);
-        res.mask(res, n);
-    }
+    finalize_and_(processor, n_bits, args[ii + 1], jj,
+            DIV_CEIL(n_bits, T::default_length));
     for (ii += 4; ii < (int) args.size(); ii += 4) {
-        int n_bits = args[ii];
-        int out = args[ii + 1];
-        for (jj = 0; jj < DIV_CEIL(n_bits, T::default_length); jj++) {
-            int n = min(T::default_length, n_bits - jj * T::default_length);
-            auto& res = processor.S[out + jj];
-            protocol->finalize_mult(res, n);
-            res.mask(res, n);
-        }
+        n_bits = args[ii];
+        finalize_and_(processor, n_bits, args[ii + 1], 0,
+                DIV_CEIL(n_bits, T::default_length));
     }
 }
 
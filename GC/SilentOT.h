@@ -13,6 +13,8 @@
 #include <algorithm>
 #include <stdexcept>
 #include <atomic>
+#include <future>
+#include <vector>
 
 #include "Tools/performance.h"
 
@@ -88,6 +90,10 @@ public:
   emp::FerretCOT<IO>* ferret;
   emp::MITCCRH<8> mitccrh;
 
+  // number of OTs per chunk in the streaming calls, a multiple of
+  // emp::ot_bsize
+  static constexpr int64_t stream_chunk_size = 1 << 16;
+
   SilentOT(int party, int threads, IO** ios, bool malicious = false,
            bool run_setup = true, std::string pre_file = "", bool warm_up = true) {
     ferret = new emp::FerretCOT<IO>(party, threads, ios, malicious, run_setup, emp::ferret_b13, pre_file);
@@ -113,78 +119,111 @@ public:
 
   ~SilentOT() { delete ferret; }
 
-  // chosen xor correlated message, chosen choice
-  // Sender chooses one message 'corr'. A correlation is defined by the xor
-  // function: f(x) = x XOR corr Sender receives a random message 'x' as output
-  // ('data0').
-  void send_ot_cxm_cc(emp::block* data0, const emp::block* corr, int64_t length) {
-    emp::block* rcm_data = new emp::block[length];
-    send_ot_rcm_cc(rcm_data, length);
+private:
+  // reused across calls, two of each to alternate between chunks
+  std::vector<emp::block> rcm_buf[2], msg_buf[2];
 
-    emp::block pad[2 * emp::ot_bsize];
-    uint32_t corrected_bsize;
-    emp::block corr_data[emp::ot_bsize];
-    uint8_t* send_buf = new uint8_t[sizeof(emp::block) * length];
-    uint64_t to_sent = 0;
+  // hashing works on whole emp::ot_bsize blocks
+  static int64_t padded(int64_t size) {
+    return (size + emp::ot_bsize - 1) / emp::ot_bsize * emp::ot_bsize;
+  }
 
-    for (int64_t i = 0; i < length; i += emp::ot_bsize) {
-      for (int64_t j = i; j < std::min(i + emp::ot_bsize, length); ++j) {
-        pad[2 * (j - i)] = rcm_data[j];
-        pad[2 * (j - i) + 1] = rcm_data[j] ^ ferret->Delta;
+  // hash one chunk of random correlated OTs into the sender output and
+  // the corrections to be sent
+  void hash_cxm_chunk(emp::block* data0, emp::block* corr_data,
+                      const emp::block* rcm_data, const emp::block* corr,
+                      int64_t size) {
+    emp::block pad[2 * emp::ot_bsize];
+    for (int64_t i = 0; i < size; i += emp::ot_bsize) {
+      int64_t bsize = std::min(emp::ot_bsize, size - i);
+      for (int64_t j = 0; j < bsize; ++j) {
+        pad[2 * j] = rcm_data[i + j];
+        pad[2 * j + 1] = rcm_data[i + j] ^ ferret->Delta;
       }
 
       ferret->mitccrh.template hash<emp::ot_bsize, 2>(pad);
 
-      for (int j = i; j < i + emp::ot_bsize and j < length; ++j) {
-        data0[j] = pad[2 * (j - i)];
-        corr_data[j - i] = corr[j] ^ data0[j] ^ pad[2 * (j - i) + 1];
+      for (int64_t j = 0; j < bsize; ++j) {
+        data0[i + j] = pad[2 * j];
+        corr_data[i + j] = corr[i + j] ^ data0[i + j] ^ pad[2 * j + 1];
       }
-      corrected_bsize = std::min(emp::ot_bsize, length - i);
-      // ferret->io->send_data(corr_data, sizeof(emp::block) * corrected_bsize);
-      memcpy(send_buf + to_sent, corr_data, sizeof(emp::block) * corrected_bsize);
-      to_sent += sizeof(emp::block) * corrected_bsize;
     }
-    ferret->io->send_data(send_buf, to_sent);
-    delete [] send_buf;
+  }
 
-    delete[] rcm_data;
+public:
+
+  // chosen xor correlated message, chosen choice
+  // Sender chooses one message 'corr'. A correlation is defined by the xor
+  // function: f(x) = x XOR corr Sender receives a random message 'x' as output
+  // ('data0').
+  // The OTs are processed in chunks of 'stream_chunk_size': the corrections
+  // of chunk i-1 are sent in the background while chunk i is hashed, and the
+  // buffers are kept for the next call.
+  void send_ot_cxm_cc(emp::block* data0, const emp::block* corr, int64_t length) {
+    int64_t chunk = std::min(stream_chunk_size, length);
+    rcm_buf[0].resize(padded(chunk));
+    for (auto& buf : msg_buf)
+      buf.resize(padded(chunk));
+
+    std::future<void> sending;
+    int64_t prev = 0;
+    for (int64_t i = 0; i < length; i += chunk) {
+      int64_t size = std::min(chunk, length - i);
+      // Ferret is interactive, so the channel must be idle here
+      send_ot_rcm_cc(rcm_buf[0].data(), size);
+      if (i > 0) {
+        emp::block* buf = msg_buf[(i / chunk - 1) % 2].data();
+        sending = std::async(std::launch::async, [this, buf, prev] {
+          ferret->io->send_data(buf, sizeof(emp::block) * prev);
+        });
+      }
+      hash_cxm_chunk(data0 + i, msg_buf[(i / chunk) % 2].data(),
+                     rcm_buf[0].data(), corr + i, size);
+      if (sending.valid())
+        sending.get();
+      prev = size;
+    }
+    if (length > 0)
+      ferret->io->send_data(msg_buf[((length - 1) / chunk) % 2].data(),
+                            sizeof(emp::block) * prev);
   }
 
   // chosen xor correlated message, chosen choice
   // Receiver chooses a choice bit 'b', and
   // receives 'x' if b = 0, and 'x XOR corr' if b = 1
+  // Mirrors the chunking of 'send_ot_cxm_cc': the random OTs of chunk i+1
+  // are generated before the corrections of chunk i are received, which are
+  // then received in the background while chunk i is hashed.
   void recv_ot_cxm_cc(emp::block* data, const bool* b, int64_t length) {
-    emp::block* rcm_data = new emp::block[length];
-    recv_ot_rcm_cc(rcm_data, b, length);
-
-    emp::block pad[emp::ot_bsize];
-
-    uint32_t corrected_bsize;
-    emp::block corr_data[emp::ot_bsize];
-
-    uint8_t* recv_buf = new uint8_t[sizeof(emp::block) * length];
-    ferret->io->recv_data(recv_buf, sizeof(emp::block) * length);
-    uint64_t recv_buf_idx = 0;
-
-    for (int64_t i = 0; i < length; i += emp::ot_bsize) {
-      corrected_bsize = std::min(emp::ot_bsize, length - i);
-
-      memcpy(pad, rcm_data + i, corrected_bsize * sizeof(emp::block));
-      ferret->mitccrh.template hash<emp::ot_bsize, 1>(pad);
-
-      // ferret->io->recv_data(corr_data, sizeof(emp::block) * corrected_bsize);
-      memcpy(corr_data, recv_buf+recv_buf_idx, sizeof(emp::block) * corrected_bsize);
-      recv_buf_idx += sizeof(emp::block) * corrected_bsize;
-
-      for (int j = i; j < i + emp::ot_bsize and j < length; ++j) {
-        if (b[j])
-          data[j] = corr_data[j - i] ^ pad[j - i];
+    int64_t chunk = std::min(stream_chunk_size, length);
+    for (auto& buf : rcm_buf)
+      buf.resize(padded(chunk));
+    msg_buf[0].resize(padded(chunk));
+
+    if (length > 0)
+      recv_ot_rcm_cc(rcm_buf[0].data(), b, chunk);
+    for (int64_t i = 0; i < length; i += chunk) {
+      int64_t size = std::min(chunk, length - i);
+      int64_t next = i + chunk;
+      if (next < length)
+        recv_ot_rcm_cc(rcm_buf[(next / chunk) % 2].data(), b + next,
+                       std::min(chunk, length - next));
+      emp::block* buf = msg_buf[0].data();
+      auto receiving = std::async(std::launch::async, [this, buf, size] {
+        ferret->io->recv_data(buf, sizeof(emp::block) * size);
+      });
+      emp::block* pad = rcm_buf[(i / chunk) % 2].data();
+      for (int64_t j = 0; j < size; j += emp::ot_bsize)
+        ferret->mitccrh.template hash<emp::ot_bsize, 1>(pad + j);
+      receiving.get();
+
+      for (int64_t j = 0; j < size; ++j) {
+        if (b[i + j])
+          data[i + j] = buf[j] ^ pad[j];
         else
-          data[j] = pad[j - i];
+          data[i + j] = pad[j];
       }
     }
-    delete[] recv_buf;
-    delete[] rcm_data;
   }
 
   // chosen message, chosen choice
@@ -132,7 +132,7 @@ public:
         return *this;
     }
 
-    This get_bit(int i)
+    This get_bit(int i) const
     {
         assert(i == 0);
         return lsb();
@@ -0,0 +1,151 @@
+/*
+ * TinyOTTripleProducer.h
+ *
+ */
+
+#ifndef GC_TINYOTTRIPLEPRODUCER_H_
+#define GC_TINYOTTRIPLEPRODUCER_H_
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <assert.h>
+
+#include "Math/field_types.h"
+
+namespace GC
+{
+
+/**
+ * Background generation of TinyOT triples (and the random bits needed
+ * for converting them) for ``RmfeSharePrep``, so that the next batch is
+ * produced while the current one is converted and sacrificed.
+ * ``generate()`` also serves bit share types whose preprocessing relies
+ * on thread-local state and hence has to run in the calling thread.
+ *
+ * Production is demand-driven: the constructor requests ``depth``
+ * batches and every ``pop()`` requests one more. TinyOT generation is
+ * interactive, so both parties have to run the same number of Fpre
+ * rounds. Before every batch, the parties therefore agree whether to
+ * start it, which they only do if neither has cancelled. On destruction,
+ * the producer cancels and only completes a batch already in flight
+ * instead of all requested ones. If the peer aborts instead, the
+ * connection is closed and the pending batch fails.
+ */
+template<class T>
+class TinyOTTripleProducer
+{
+public:
+    struct Batch
+    {
+        // packed triples arranged as n x 3 x l
+        std::vector<T> triples;
+        std::vector<T> masks;
+    };
+
+private:
+    typename T::LivePrep& prep;
+    int n, l, n_masks;
+    size_t depth;
+
+    std::deque<Batch> batches;
+    std::mutex mutex;
+    std::condition_variable ready, requests;
+    size_t n_requested, n_produced;
+    bool cancelled;
+    std::exception_ptr error;
+    std::thread producer;
+
+    void run()
+    {
+        try
+        {
+            while (true)
+            {
+                bool go;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    requests.wait(lock,
+                            [this] { return n_produced < n_requested or cancelled; });
+                    go = not cancelled;
+                }
+                // both parties start the batch or neither does
+                if (not prep.both_continue(go))
+                {
+                    if (go)
+                        throw std::runtime_error("TinyOT producer cancelled by peer");
+                    return;
+                }
+                Batch batch;
+                generate(batch, prep, n, l, n_masks);
+                std::lock_guard<std::mutex> lock(mutex);
+                batches.push_back(std::move(batch));
+                n_produced++;
+                ready.notify_one();
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            ready.notify_one();
+        }
+    }
+
+public:
+    static void generate(Batch& batch, typename T::LivePrep& prep, int n,
+            int l, int n_masks)
+    {
+        auto& triples = batch.triples;
+        triples.resize(n * 3 * l);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < l; j++)
+                prep.get_three_no_count(DATA_TRIPLE, triples[i * 3 * l + j],
+                        triples[i * 3 * l + l + j],
+                        triples[i * 3 * l + 2 * l + j]);
+        batch.masks.resize(n_masks);
+        for (auto& x : batch.masks)
+            x = prep.get_bit();
+    }
+
+    TinyOTTripleProducer(typename T::LivePrep& prep, int n, int l, int n_masks,
+            size_t depth = 1) :
+            prep(prep), n(n), l(l), n_masks(n_masks), depth(depth),
+            n_requested(depth), n_produced(0), cancelled(false)
+    {
+        assert(depth > 0);
+        producer = std::thread([this] { run(); });
+    }
+
+    ~TinyOTTripleProducer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // batches not started yet are skipped by both parties
+            cancelled = true;
+            requests.notify_one();
+        }
+        producer.join();
+    }
+
+    Batch pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return not batches.empty() or error; });
+        if (batches.empty())
+            std::rethrow_exception(error);
+        Batch res = std::move(batches.front());
+        batches.pop_front();
+        n_requested++;
+        requests.notify_one();
+        return res;
+    }
+};
+
+}
+
+#endif /* GC_TINYOTTRIPLEPRODUCER_H_ */
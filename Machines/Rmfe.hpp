@@ -31,6 +31,15 @@
 #include "Protocols/TinyOt2Rmfe.hpp"
 #include "Protocols/RmfeShareConverter.hpp"
 
+// Tinier provides the bit triples for more than two parties
+#include "GC/TinierSecret.h"
+#include "GC/TinyMC.h"
+#include "GC/VectorInput.h"
+#include "GC/CcdPrep.hpp"
+#include "GC/TinierSharePrep.hpp"
+#include "GC/TinyPrep.hpp"
+#include "Protocols/Beaver.hpp"
+
 #include "OT/NPartyTripleGenerator.hpp"
 
 #include "Math/Square.hpp"
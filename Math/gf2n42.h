@@ -0,0 +1,362 @@
+/*
+ * gf2n42.h
+ *
+ */
+
+#ifndef MATH_GF2N42_H_
+#define MATH_GF2N42_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Math/gf2nlong.h"
+#include "Tools/cpu_support.h"
+
+/**
+ * Vector operations used by ``gf2n42``, one specialisation per register
+ * width. Carry-less products are taken per 128-bit lane, that is, on
+ * words 0, 2, ... or 1, 3, ... depending on ``C``.
+ */
+template<class V>
+class gf2n42_lanes;
+
+template<>
+class gf2n42_lanes<__m128i>
+{
+public:
+    static const int N = 2;
+
+    static bool available() { return true; }
+
+    static __m128i load(const uint64_t* x) { return _mm_loadu_si128((const __m128i*) x); }
+    static void store(uint64_t* x, __m128i y) { _mm_storeu_si128((__m128i*) x, y); }
+    static __m128i set1(uint64_t x) { return _mm_set1_epi64x(x); }
+    static __m128i zero() { return _mm_setzero_si128(); }
+
+    static __m128i XOR(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+    static __m128i AND(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+    template<int K>
+    static __m128i srli(__m128i a) { return _mm_srli_epi64(a, K); }
+    template<int K>
+    static __m128i slli(__m128i a) { return _mm_slli_epi64(a, K); }
+    static __m128i unpacklo(__m128i a, __m128i b) { return _mm_unpacklo_epi64(a, b); }
+    static __m128i unpackhi(__m128i a, __m128i b) { return _mm_unpackhi_epi64(a, b); }
+
+    template<int C>
+    static __m128i clmul(__m128i a, __m128i b) { return ::clmul<C>(a, b); }
+};
+
+#ifdef __VPCLMULQDQ__
+template<>
+class gf2n42_lanes<__m256i>
+{
+public:
+    static const int N = 4;
+
+    static bool available() { return cpu_has_vpclmul(); }
+
+    static __m256i load(const uint64_t* x) { return _mm256_loadu_si256((const __m256i*) x); }
+    static void store(uint64_t* x, __m256i y) { _mm256_storeu_si256((__m256i*) x, y); }
+    static __m256i set1(uint64_t x) { return _mm256_set1_epi64x(x); }
+    static __m256i zero() { return _mm256_setzero_si256(); }
+
+    static __m256i XOR(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+    static __m256i AND(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+    template<int K>
+    static __m256i srli(__m256i a) { return _mm256_srli_epi64(a, K); }
+    template<int K>
+    static __m256i slli(__m256i a) { return _mm256_slli_epi64(a, K); }
+    static __m256i unpacklo(__m256i a, __m256i b) { return _mm256_unpacklo_epi64(a, b); }
+    static __m256i unpackhi(__m256i a, __m256i b) { return _mm256_unpackhi_epi64(a, b); }
+
+    template<int C>
+    static __m256i clmul(__m256i a, __m256i b) { return _mm256_clmulepi64_epi128(a, b, C); }
+};
+
+#ifdef __AVX512F__
+template<>
+class gf2n42_lanes<__m512i>
+{
+public:
+    static const int N = 8;
+
+    static bool available() { return cpu_has_vpclmul() and cpu_has_avx512f(); }
+
+    static __m512i load(const uint64_t* x) { return _mm512_loadu_si512(x); }
+    static void store(uint64_t* x, __m512i y) { _mm512_storeu_si512(x, y); }
+    static __m512i set1(uint64_t x) { return _mm512_set1_epi64(x); }
+    static __m512i zero() { return _mm512_setzero_si512(); }
+
+    static __m512i XOR(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+    static __m512i AND(__m512i a, __m512i b) { return _mm512_and_si512(a, b); }
+    // the unmasked versions trigger -Wmaybe-uninitialized with GCC 12
+    template<int K>
+    static __m512i srli(__m512i a) { return _mm512_maskz_srli_epi64(0xFF, a, K); }
+    template<int K>
+    static __m512i slli(__m512i a) { return _mm512_maskz_slli_epi64(0xFF, a, K); }
+    static __m512i unpacklo(__m512i a, __m512i b) { return _mm512_maskz_unpacklo_epi64(0xFF, a, b); }
+    static __m512i unpackhi(__m512i a, __m512i b) { return _mm512_maskz_unpackhi_epi64(0xFF, a, b); }
+
+    template<int C>
+    static __m512i clmul(__m512i a, __m512i b) { return _mm512_clmulepi64_epi128(a, b, C); }
+};
+#endif
+#endif
+
+/**
+ * Batch arithmetic in GF(2^42) = GF(2)[X]/(X^42+X^7+X^4+X^3+1)
+ * on raw 64-bit words, as used by RMFE-encoded shares.
+ *
+ * Elements are processed eight, four, or two at a time with carry-less
+ * multiplication, depending on whether VPCLMULQDQ with 512 or 256 bits
+ * is available, and a shift-based reduction that is shared by all
+ * products summed into the same result. ``clmul()`` falls back to
+ * software without PCLMUL.
+ */
+class gf2n42
+{
+    template<class V>
+    static V fold(V h)
+    {
+        typedef gf2n42_lanes<V> L;
+        V r = L::XOR(h, L::template slli<3>(h));
+        r = L::XOR(r, L::template slli<4>(h));
+        return L::XOR(r, L::template slli<7>(h));
+    }
+
+    template<class V>
+    static V reduce(V lo, V hi)
+    {
+        // fold bits 42..82 onto bits 0..48 and then 42..48 onto 0..13
+        typedef gf2n42_lanes<V> L;
+        V mask = L::set1(MASK);
+        V h = L::XOR(L::template srli<DEGREE>(lo),
+                L::template slli<64 - DEGREE>(hi));
+        V r = L::XOR(L::AND(lo, mask), fold(h));
+        h = L::template srli<DEGREE>(r);
+        return L::XOR(L::AND(r, mask), fold(h));
+    }
+
+    // unreduced products of all words, low and high halves
+    template<class V>
+    static void mul_unreduced(V a, V b, V& lo, V& hi)
+    {
+        typedef gf2n42_lanes<V> L;
+        V p0 = L::template clmul<0x00>(a, b);
+        V p1 = L::template clmul<0x11>(a, b);
+        lo = L::unpacklo(p0, p1);
+        hi = L::unpackhi(p0, p1);
+    }
+
+    // The following process whole registers from ``i`` on
+    // and return where the next width has to continue.
+
+    template<class V>
+    static size_t dot(uint64_t& res, const uint64_t* x, const uint64_t* y,
+            size_t i, size_t n)
+    {
+        typedef gf2n42_lanes<V> L;
+        if (n - i < size_t(L::N) or not L::available())
+            return i;
+        V lo = L::zero(), hi = L::zero();
+        for (; i + L::N <= n; i += L::N)
+        {
+            V lo2, hi2;
+            mul_unreduced(L::load(x + i), L::load(y + i), lo2, hi2);
+            lo = L::XOR(lo, lo2);
+            hi = L::XOR(hi, hi2);
+        }
+        uint64_t all[L::N];
+        L::store(all, reduce(lo, hi));
+        for (int j = 0; j < L::N; j++)
+            res ^= all[j];
+        return i;
+    }
+
+    template<class V>
+    static size_t mul(uint64_t* res, const uint64_t* a, const uint64_t* b,
+            size_t i, size_t n)
+    {
+        typedef gf2n42_lanes<V> L;
+        if (not L::available())
+            return i;
+        for (; i + L::N <= n; i += L::N)
+        {
+            V lo, hi;
+            mul_unreduced(L::load(a + i), L::load(b + i), lo, hi);
+            L::store(res + i, reduce(lo, hi));
+        }
+        return i;
+    }
+
+    template<class V>
+    static size_t mul(uint64_t* res, const uint64_t* a, uint64_t b, size_t i,
+            size_t n)
+    {
+        typedef gf2n42_lanes<V> L;
+        if (not L::available())
+            return i;
+        V bb = L::set1(b);
+        for (; i + L::N <= n; i += L::N)
+        {
+            V lo, hi;
+            mul_unreduced(L::load(a + i), bb, lo, hi);
+            L::store(res + i, reduce(lo, hi));
+        }
+        return i;
+    }
+
+    template<class V>
+    static size_t fma2(uint64_t* res, const uint64_t* c, const uint64_t* x,
+            const uint64_t* y, const uint64_t* u, const uint64_t* v, size_t i,
+            size_t n)
+    {
+        typedef gf2n42_lanes<V> L;
+        if (not L::available())
+            return i;
+        for (; i + L::N <= n; i += L::N)
+        {
+            V lo, hi, lo2, hi2;
+            mul_unreduced(L::load(x + i), L::load(y + i), lo, hi);
+            mul_unreduced(L::load(u + i), L::load(v + i), lo2, hi2);
+            lo = L::XOR(lo, lo2);
+            hi = L::XOR(hi, hi2);
+            L::store(res + i, L::XOR(L::load(c + i), reduce(lo, hi)));
+        }
+        return i;
+    }
+
+public:
+    static const int DEGREE = 42;
+    static const uint64_t MASK = (1ULL << DEGREE) - 1;
+    static const int PACKED_SIZE = (DEGREE + 7) / 8;
+
+    static uint64_t reduce(uint64_t lo, uint64_t hi)
+    {
+        uint64_t h = (lo >> DEGREE) | (hi << (64 - DEGREE));
+        uint64_t r = (lo & MASK) ^ h ^ (h << 3) ^ (h << 4) ^ (h << 7);
+        h = r >> DEGREE;
+        return (r & MASK) ^ h ^ (h << 3) ^ (h << 4) ^ (h << 7);
+    }
+
+    static uint64_t mul(uint64_t a, uint64_t b)
+    {
+        __m128i p = clmul<0x00>(_mm_cvtsi64_si128(a), _mm_cvtsi64_si128(b));
+        return reduce(uint64_t(_mm_cvtsi128_si64(p)),
+                uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(p, p))));
+    }
+
+    /// ``sum_i x[i] * y[i]`` with one reduction per register width
+    static uint64_t dot(const uint64_t* x, const uint64_t* y, size_t n)
+    {
+        size_t i = 0;
+        uint64_t res = 0;
+#ifdef __VPCLMULQDQ__
+#ifdef __AVX512F__
+        i = dot<__m512i>(res, x, y, i, n);
+#endif
+        i = dot<__m256i>(res, x, y, i, n);
+#endif
+        i = dot<__m128i>(res, x, y, i, n);
+        for (; i < n; i++)
+            res ^= mul(x[i], y[i]);
+        return res;
+    }
+
+    /// ``res[i] = a[i] * b[i]``
+    static void mul(uint64_t* res, const uint64_t* a, const uint64_t* b,
+            size_t n)
+    {
+        size_t i = 0;
+#ifdef __VPCLMULQDQ__
+#ifdef __AVX512F__
+        i = mul<__m512i>(res, a, b, i, n);
+#endif
+        i = mul<__m256i>(res, a, b, i, n);
+#endif
+        i = mul<__m128i>(res, a, b, i, n);
+        for (; i < n; i++)
+            res[i] = mul(a[i], b[i]);
+    }
+
+    /// ``res[i] = a[i] * b``
+    static void mul(uint64_t* res, const uint64_t* a, uint64_t b, size_t n)
+    {
+        size_t i = 0;
+#ifdef __VPCLMULQDQ__
+#ifdef __AVX512F__
+        i = mul<__m512i>(res, a, b, i, n);
+#endif
+        i = mul<__m256i>(res, a, b, i, n);
+#endif
+        i = mul<__m128i>(res, a, b, i, n);
+        for (; i < n; i++)
+            res[i] = mul(a[i], b);
+    }
+
+    /// ``res[i] = c[i] + x[i] * y[i] + u[i] * v[i]`` with one reduction
+    static void fma2(uint64_t* res, const uint64_t* c, const uint64_t* x,
+            const uint64_t* y, const uint64_t* u, const uint64_t* v, size_t n)
+    {
+        size_t i = 0;
+#ifdef __VPCLMULQDQ__
+#ifdef __AVX512F__
+        i = fma2<__m512i>(res, c, x, y, u, v, i, n);
+#endif
+        i = fma2<__m256i>(res, c, x, y, u, v, i, n);
+#endif
+        i = fma2<__m128i>(res, c, x, y, u, v, i, n);
+        for (; i < n; i++)
+            res[i] = c[i] ^ mul(x[i], y[i]) ^ mul(u[i], v[i]);
+    }
+
+    /// Write ``n`` elements to ``PACKED_SIZE * n`` bytes (little-endian)
+    static void pack(uint8_t* res, const uint64_t* x, size_t n)
+    {
+        size_t i = 0;
+        // 16-byte stores overwrite the four bytes after each pair,
+        // which belong to the next element at the latest
+#ifdef __SSSE3__
+        __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12,
+                13, -1, -1, -1, -1);
+        for (; i + 2 < n; i += 2)
+            _mm_storeu_si128((__m128i*) (res + PACKED_SIZE * i),
+                    _mm_shuffle_epi8(_mm_loadu_si128((__m128i*) (x + i)),
+                            shuffle));
+#endif
+        for (; i < n; i++)
+            memcpy(res + PACKED_SIZE * i, x + i, PACKED_SIZE);
+    }
+
+    /// Read ``n`` elements from ``PACKED_SIZE * n`` bytes and reduce to
+    /// ``DEGREE`` bits; add to ``res`` instead of overwriting if ``ADD``
+    template<bool ADD = false>
+    static void unpack(uint64_t* res, const uint8_t* x, size_t n)
+    {
+        size_t i = 0;
+#ifdef __SSSE3__
+        __m128i shuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9,
+                10, 11, -1, -1);
+        __m128i mask = _mm_set1_epi64x(MASK);
+        for (; i + 2 < n; i += 2)
+        {
+            __m128i y = _mm_and_si128(mask, _mm_shuffle_epi8(
+                    _mm_loadu_si128((__m128i*) (x + PACKED_SIZE * i)),
+                    shuffle));
+            if (ADD)
+                y = _mm_xor_si128(y, _mm_loadu_si128((__m128i*) (res + i)));
+            _mm_storeu_si128((__m128i*) (res + i), y);
+        }
+#endif
+        for (; i < n; i++)
+        {
+            uint64_t y = 0;
+            memcpy(&y, x + PACKED_SIZE * i, PACKED_SIZE);
+            y &= MASK;
+            res[i] = ADD ? res[i] ^ y : y;
+        }
+    }
+};
+
+#endif /* MATH_GF2N42_H_ */
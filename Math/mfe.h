@@ -16,6 +16,11 @@
 #include <vector>
 #include <unordered_map>
 #include <queue>
+#include <mutex>
+#include <functional>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
 #include <assert.h>
 
 #define USE_CACHE 1
@@ -167,6 +172,93 @@ public:
 };
 
 
+/**
+ * Per-thread access to an (R)MFE instance, which is either owned by the
+ * thread or shared by the whole process. A shared instance is frozen
+ * once, after which it is read-only and safe to use from any thread.
+ */
+template<class T>
+class MfeSingleton {
+    static thread_local T* singleton;
+    static thread_local unique_ptr<T> owned;
+    static unique_ptr<T> shared;
+    static std::mutex shared_mutex;
+
+public:
+    static void set_singleton(unique_ptr<T> s) {
+        owned = std::move(s);
+        singleton = owned.get();
+    }
+
+    static T& s() {
+        if (singleton)
+            return *singleton;
+        else
+            throw runtime_error("no singleton: " + std::string(typeid(T).name()));
+    }
+
+    static bool has_singleton() {
+        return singleton;
+    }
+
+    static void reset_singleton() {
+        singleton = 0;
+        owned.reset();
+    }
+
+    /**
+     * Use the process-wide instance in this thread, which is created with
+     * ``make`` and frozen by the first caller. If ``cache`` is given, the
+     * frozen tables are read from there or written there for next time.
+     * A cache written for another parameter set ``name`` or for other
+     * fields and maps is ignored and overwritten.
+     */
+    static T& setup_shared(std::function<unique_ptr<T>()> make,
+            const std::string& cache = "", const std::string& name = "");
+};
+
+template<class T>
+thread_local T* MfeSingleton<T>::singleton(0);
+
+template<class T>
+thread_local unique_ptr<T> MfeSingleton<T>::owned;
+
+template<class T>
+unique_ptr<T> MfeSingleton<T>::shared;
+
+template<class T>
+std::mutex MfeSingleton<T>::shared_mutex;
+
+template<class T>
+T& MfeSingleton<T>::setup_shared(std::function<unique_ptr<T>()> make,
+        const std::string& cache, const std::string& name) {
+    std::lock_guard<std::mutex> lock(shared_mutex);
+    if (not shared) {
+        unique_ptr<T> res = make();
+        std::ifstream in(cache, std::ios::binary);
+        std::string cached_name;
+        if (in)
+            std::getline(in, cached_name, '\0');
+        if (cache.empty() or not in or cached_name != name
+                or not res->load_tables(in)) {
+            res->freeze();
+            if (not cache.empty()) {
+                // other processes might be reading the same file
+                std::string tmp = cache + "." + std::to_string(getpid());
+                std::ofstream out(tmp, std::ios::binary);
+                out.write(name.c_str(), name.size() + 1);
+                res->save_tables(out);
+                out.close();
+                if (out.fail() or std::rename(tmp.c_str(), cache.c_str()))
+                    std::remove(tmp.c_str());
+            }
+        }
+        shared = std::move(res);
+    }
+    singleton = shared.get();
+    return *singleton;
+}
+
 /**
  * MFE interface.
  * 
@@ -176,22 +268,20 @@ public:
  * T4: Extension field modulus type 
 */
 template <class T1, class T2, class T3, class T4>
-class MFE {
+class MFE : public MfeSingleton<MFE<T1, T2, T3, T4>> {
     typedef MFE<T1, T2, T3, T4> This;
-    // use thread_local because we need to use cache for encode/decode and the cache is not thread-safe
-    static thread_local unique_ptr<This> singleton;
 public:
     virtual ~MFE() {};
 
-    static void set_singleton(unique_ptr<This> s);
-    static MFE& s();
-    static bool has_singleton() {
-        return bool(singleton);
-    }
-    static void reset_singleton() {
-        if (has_singleton())
-            singleton.reset(nullptr);
-    }
+    /**
+     * Compute everything that is otherwise cached on demand,
+     * after which encoding and decoding do not modify the instance.
+     */
+    virtual void freeze() {}
+    /// Store the tables computed by ``freeze()``
+    virtual void save_tables(std::ostream&) {}
+    /// Restore the tables from ``save_tables()``, returns false on mismatch
+    virtual bool load_tables(std::istream&) { return false; }
 
     virtual long m() = 0;
     virtual long t() = 0;
@@ -220,22 +310,6 @@ public:
     }
 };
 
-template<class T1, class T2, class T3, class T4>
-thread_local unique_ptr<MFE<T1, T2, T3, T4>> MFE<T1, T2, T3, T4>::singleton(nullptr);
-
-template<class T1, class T2, class T3, class T4>
-inline MFE<T1, T2, T3, T4>& MFE<T1, T2, T3, T4>::s()
-{
-    if (singleton)
-        return *singleton;
-    else
-        throw runtime_error("no singleton: " + std::string(typeid(MFE<T1, T2, T3, T4>).name()));
-}
-
-template<class T1, class T2, class T3, class T4>
-inline void MFE<T1, T2, T3, T4>::set_singleton(unique_ptr<MFE<T1, T2, T3, T4>> s) {
-    singleton = std::move(s);
-}
 
 
 typedef MFE<NTL::GF2EX, NTL::vec_GF2E, NTL::GF2X, NTL::GF2EX> Gf2eMFE;
@@ -402,23 +476,20 @@ public:
  * T4: Extension field modulus type 
 */
 template <class T1, class T2, class T3, class T4>
-class RMFE {
+class RMFE : public MfeSingleton<RMFE<T1, T2, T3, T4>> {
     typedef RMFE<T1, T2, T3, T4> This;
-    // use thread_local because we need to use cache for encode/decode and the cache is not thread-safe
-    static thread_local unique_ptr<This> singleton;
-
 public:
     virtual ~RMFE() {};
 
-    static void set_singleton(unique_ptr<This> s);
-    static RMFE& s();
-    static bool has_singleton() {
-        return bool(singleton);
-    }
-    static void reset_singleton() {
-        if (has_singleton())
-            singleton.reset(nullptr);
-    }
+    /**
+     * Compute everything that is otherwise cached on demand,
+     * after which encoding and decoding do not modify the instance.
+     */
+    virtual void freeze() {}
+    /// Store the tables computed by ``freeze()``
+    virtual void save_tables(std::ostream&) {}
+    /// Restore the tables from ``save_tables()``, returns false on mismatch
+    virtual bool load_tables(std::istream&) { return false; }
 
     virtual long m() = 0;
     virtual long k() = 0;
@@ -465,22 +536,6 @@ public:
 
 };
 
-template<class T1, class T2, class T3, class T4>
-thread_local unique_ptr<RMFE<T1, T2, T3, T4>> RMFE<T1, T2, T3, T4>::singleton(nullptr);
-
-template<class T1, class T2, class T3, class T4>
-inline RMFE<T1, T2, T3, T4>& RMFE<T1, T2, T3, T4>::s()
-{
-    if (singleton)
-        return *singleton;
-    else
-        throw runtime_error("no singleton: " + std::string(typeid(RMFE<T1, T2, T3, T4>).name()));
-}
-
-template<class T1, class T2, class T3, class T4>
-inline void RMFE<T1, T2, T3, T4>::set_singleton(unique_ptr<RMFE<T1, T2, T3, T4>> s) {
-    singleton = std::move(s);
-}
 
 typedef RMFE<NTL::vec_GF2E, NTL::GF2EX, NTL::GF2X, NTL::GF2EX> Gf2eRMFE;
 typedef RMFE<NTL::vec_GF2, NTL::GF2X, long, NTL::GF2X> Gf2RMFE;
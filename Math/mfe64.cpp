@@ -23,6 +23,68 @@
 
 using namespace std;
 
+// Raw table storage for `save_tables`/`load_tables`, each entry with a length prefix.
+namespace
+{
+
+void save_word(ostream& o, uint64_t x) {
+    o.write((const char*) &x, sizeof(x));
+}
+
+bool load_word(istream& i, uint64_t expected) {
+    uint64_t x;
+    i.read((char*) &x, sizeof(x));
+    return i and x == expected;
+}
+
+template<class T>
+void save_table(ostream& o, const vector<T>& x) {
+    save_word(o, x.size());
+    o.write((const char*) x.data(), x.size() * sizeof(T));
+}
+
+template<class T>
+bool load_table(istream& i, vector<T>& x, size_t size) {
+    if (not load_word(i, size))
+        return false;
+    x.resize(size);
+    i.read((char*) x.data(), size * sizeof(T));
+    return bool(i);
+}
+
+// FNV-1a over the moduli and the encoding/decoding matrices, which are stored
+// with the tables to reject tables of other fields or maps.
+const uint64_t hash_init = 0xcbf29ce484222325;
+
+void hash_word(uint64_t& h, uint64_t x) {
+    for (int i = 0; i < 8; i++, x >>= 8) {
+        h ^= x & 0xFF;
+        h *= 0x100000001b3;
+    }
+}
+
+void hash_poly(uint64_t& h, const NTL::GF2X& f) {
+    hash_word(h, deg(f));
+    for (long i = 0; i <= deg(f); i += 64) {
+        uint64_t x = 0;
+        for (long j = i; j <= min(deg(f), i + 63); j++)
+            x |= uint64_t(IsOne(coeff(f, j))) << (j - i);
+        hash_word(h, x);
+    }
+}
+
+void hash_bits(uint64_t& h, const NTL::vec_GF2& v) {
+    hash_word(h, v.length());
+    for (long i = 0; i < v.length(); i += 64) {
+        uint64_t x = 0;
+        for (long j = i; j < min(v.length(), i + 64); j++)
+            x |= uint64_t(IsOne(v[j])) << (j - i);
+        hash_word(h, x);
+    }
+}
+
+}
+
 ostream& operator<<(ostream& s, const vec_gf2e& a) { 
    long i, n;   
   
@@ -533,6 +595,57 @@ gf2x64 CompositeGf2MFE64::decode(vec_gf2_64 h) {
     return g;
 }
 
+void CompositeGf2MFE64::freeze() {
+    mfe1_->freeze();
+    mfe2_->freeze();
+    if (use_cache_ && use_encode_table_)
+        for (gf2x64 g = 0; g < encode_table_.size(); g++)
+            encode(g);
+    if (use_cache_ && use_decode_table_)
+        for (vec_gf2_64 h = 0; h < decode_table_.size(); h++)
+            decode(h);
+    // The maps would keep changing, so larger inputs are always computed.
+    use_encode_map_ = false;
+    use_decode_map_ = false;
+}
+
+uint64_t CompositeGf2MFE64::fingerprint() {
+    uint64_t h = hash_init;
+    hash_poly(h, ex_field_mod());
+    for (long i = 0; i < m_; i++)
+        hash_word(h, encode(gf2x64(1) << i));
+    for (long i = 0; i < t_; i++)
+        hash_word(h, decode(vec_gf2_64(1) << i));
+    return h;
+}
+
+void CompositeGf2MFE64::save_tables(ostream& o) {
+    save_word(o, m_);
+    save_word(o, t_);
+    save_word(o, fingerprint());
+    save_table(o, use_encode_table_ ? encode_table_ : vector<vec_gf2_64>());
+    save_table(o, use_decode_table_ ? decode_table_ : vector<gf2x64>());
+}
+
+bool CompositeGf2MFE64::load_tables(istream& i) {
+    vector<vec_gf2_64> encode_table;
+    vector<gf2x64> decode_table;
+    if (not (load_word(i, m_) and load_word(i, t_) and load_word(i, fingerprint())
+            and load_table(i, encode_table, use_encode_table_ ? encode_table_.size() : 0)
+            and load_table(i, decode_table, use_decode_table_ ? decode_table_.size() : 0)))
+        return false;
+
+    mfe1_->freeze();
+    mfe2_->freeze();
+    encode_table_.swap(encode_table);
+    decode_table_.swap(decode_table);
+    encode_table_cached_.assign(encode_table_.size(), true);
+    decode_table_cached_.assign(decode_table_.size(), true);
+    use_encode_map_ = false;
+    use_decode_map_ = false;
+    return true;
+}
+
 CompositeGf2MFEInternal64::CompositeGf2MFEInternal64(std::shared_ptr<FieldConverter64> converter, std::shared_ptr<Gf2MFE64> mfe1, std::shared_ptr<Gf2eMFE64> mfe2)
     : converter_(converter), mfe1_(mfe1), mfe2_(mfe2) {
     if (converter->base_field_poly() != mfe2->base_field_mod())
@@ -644,6 +757,45 @@ gf2x64 CompositeGf2MFEInternal64::decode(const NTL::vec_GF2& h) {
 }
 
 
+void CompositeGf2MFEInternal64::freeze() {
+    mfe1_->freeze();
+    mfe2_->freeze();
+    // The own caches would keep changing, and the (smaller) first level
+    // is enough to avoid most of the work.
+    use_cache_ = false;
+}
+
+uint64_t CompositeGf2MFEInternal64::fingerprint() {
+    uint64_t h = hash_init;
+    hash_poly(h, ex_field_mod());
+    for (long i = 0; i < m_; i++)
+        hash_bits(h, encode(gf2x64(1) << i));
+    NTL::vec_GF2 unit;
+    unit.SetLength(t_);
+    for (long i = 0; i < t_; i++) {
+        unit[i] = 1;
+        hash_word(h, decode(unit));
+        unit[i] = 0;
+    }
+    return h;
+}
+
+void CompositeGf2MFEInternal64::save_tables(ostream& o) {
+    save_word(o, m_);
+    save_word(o, t_);
+    save_word(o, fingerprint());
+    mfe1_->save_tables(o);
+}
+
+bool CompositeGf2MFEInternal64::load_tables(istream& i) {
+    if (not (load_word(i, m_) and load_word(i, t_) and load_word(i, fingerprint())
+            and mfe1_->load_tables(i)))
+        return false;
+    mfe2_->freeze();
+    use_cache_ = false;
+    return true;
+}
+
 
 BasicRMFE64::BasicRMFE64(long k, long base_field_poly_mod_deg, bool is_type1): k_(k) {
     if (is_type1)
@@ -849,11 +1001,41 @@ CompositeGf2RMFE64::CompositeGf2RMFE64(std::shared_ptr<FieldConverter64> convert
     }
 
     base_field_context_ = NTL::GF2EContext(converter_->base_field_poly());
+
+    build_lookup_tables();
 }
 
+void CompositeGf2RMFE64::build_lookup_tables() {
+    // Evaluate the linear maps on unit vectors with the NTL-based implementation,
+    // then combine them into one table per input byte.
+    vector<gf2x64> encode_cols(k_);
+    vector<vec_gf2_64> decode_cols(m_), tau_cols(m_);
+    for (long i = 0; i < k_; i++)
+        encode_cols[i] = encode_slow(1ull << i);
+    for (long i = 0; i < m_; i++) {
+        decode_cols[i] = decode_slow(1ull << i);
+        tau_cols[i] = encode_slow(decode_cols[i]);
+    }
 
+    auto fill = [](vector<byte_table>& lut, const vector<uint64_t>& cols) {
+        lut.resize((cols.size() + 7) / 8);
+        for (size_t i = 0; i < lut.size(); i++) {
+            for (int x = 0; x < 256; x++) {
+                uint64_t y = 0;
+                for (size_t j = 0; j < 8 && i * 8 + j < cols.size(); j++)
+                    if ((x >> j) & 1)
+                        y ^= cols[i * 8 + j];
+                lut[i][x] = y;
+            }
+        }
+    };
+    fill(encode_lut_, encode_cols);
+    fill(decode_lut_, decode_cols);
+    fill(tau_lut_, tau_cols);
+    use_lut_ = true;
+}
 
-gf2x64 CompositeGf2RMFE64::encode(vec_gf2_64 h) {
+gf2x64 CompositeGf2RMFE64::encode_slow(vec_gf2_64 h) {
     
     if (use_cache_ && encode_table_cached_[h]) {
         return encode_table_[h];
@@ -878,7 +1060,7 @@ gf2x64 CompositeGf2RMFE64::encode(vec_gf2_64 h) {
     return g;
 }
 
-vec_gf2_64 CompositeGf2RMFE64::decode(gf2x64 g) {
+vec_gf2_64 CompositeGf2RMFE64::decode_slow(gf2x64 g) {
     if (use_cache_ && decode_map_.contains(g)) {
         return decode_map_.get(g);
     }
@@ -913,6 +1095,46 @@ gf2x64 CompositeGf2RMFE64::random_preimage(vec_gf2_64 h) {
     gf2e g = converter_->composite_to_binary(g_comp);
     return g;
 }
+void CompositeGf2RMFE64::freeze() {
+    if (!use_lut_)
+        build_lookup_tables();
+    // the slow paths are only used by `random_preimage`, which does not cache
+    use_cache_ = false;
+}
+
+uint64_t CompositeGf2RMFE64::fingerprint() {
+    uint64_t h = hash_init;
+    hash_poly(h, ex_field_mod());
+    for (long i = 0; i < k_; i++)
+        hash_word(h, encode(vec_gf2_64(1) << i));
+    for (long i = 0; i < m_; i++)
+        hash_word(h, decode(gf2x64(1) << i));
+    return h;
+}
+
+void CompositeGf2RMFE64::save_tables(ostream& o) {
+    save_word(o, k_);
+    save_word(o, m_);
+    save_word(o, fingerprint());
+    save_table(o, encode_lut_);
+    save_table(o, decode_lut_);
+    save_table(o, tau_lut_);
+}
+
+bool CompositeGf2RMFE64::load_tables(istream& i) {
+    vector<byte_table> encode_lut, decode_lut, tau_lut;
+    if (not (load_word(i, k_) and load_word(i, m_) and load_word(i, fingerprint())
+            and load_table(i, encode_lut, (k_ + 7) / 8)
+            and load_table(i, decode_lut, (m_ + 7) / 8)
+            and load_table(i, tau_lut, (m_ + 7) / 8)))
+        return false;
+    encode_lut_.swap(encode_lut);
+    decode_lut_.swap(decode_lut);
+    tau_lut_.swap(tau_lut);
+    use_lut_ = true;
+    use_cache_ = false;
+    return true;
+}
 
 FieldConverter64::FieldConverter64(long binary_field_deg, long base_field_deg, long extension_deg, NTL::GF2X prespecified_base_field_poly)
 : FieldConverter(binary_field_deg, base_field_deg, extension_deg, prespecified_base_field_poly) {
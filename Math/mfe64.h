@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <queue>
 #include <random>
@@ -744,6 +745,9 @@ private:
     // Using GF2E::init frequently is very expensive, so we should save the context here.
     NTL::GF2EContext base_field_context_;
 
+    /// Hash of the field modulus and the maps, stored with the tables
+    uint64_t fingerprint();
+
 public:
     using MFE::encode;
     using MFE::decode;
@@ -788,6 +792,9 @@ public:
 
     vec_gf2_64 encode(gf2x64 g);
     gf2x64 decode(vec_gf2_64 h);
+    void freeze();
+    void save_tables(std::ostream& o);
+    bool load_tables(std::istream& i);
 };
 
 /**
@@ -845,6 +852,9 @@ private:
     // Using GF2E::init frequently is very expensive, so we should save the context here.
     NTL::GF2EContext base_field_context_;
 
+    /// Hash of the field modulus and the maps, stored with the tables
+    uint64_t fingerprint();
+
 public:
     using MFE::encode;
     using MFE::decode;
@@ -887,6 +897,9 @@ public:
 
     virtual NTL::vec_GF2 encode(gf2x64 g);
     virtual gf2x64 decode(const NTL::vec_GF2& h);
+    void freeze();
+    void save_tables(std::ostream& o);
+    bool load_tables(std::istream& i);
 };
 
 
@@ -1093,11 +1106,46 @@ private:
     // Using GF2E::init frequently is very expensive, so we should save the context here.
     NTL::GF2EContext base_field_context_;
 
+    /**
+     * Byte-sliced lookup tables for encode, decode and tau. All three maps are GF(2)-linear,
+     * so `f(x) = f(x_0) ^ f(x_1 << 8) ^ ...` where `x_i` is the i-th byte of `x`.
+     * Once built, the 64-bit interfaces below never touch NTL.
+    */
+    typedef std::array<uint64_t, 256> byte_table;
+    vector<byte_table> encode_lut_;
+    vector<byte_table> decode_lut_;
+    vector<byte_table> tau_lut_;
+    bool use_lut_ = false;
+
+    void build_lookup_tables();
+
+    static uint64_t lookup(const vector<byte_table>& lut, uint64_t x) {
+        uint64_t res = 0;
+        for (size_t i = 0; i < lut.size(); i++, x >>= 8)
+            res ^= lut[i][x & 0xFF];
+        return res;
+    }
+
+    gf2x64 encode_slow(vec_gf2_64 h);
+    vec_gf2_64 decode_slow(gf2x64 g);
+
+    /// Hash of the field modulus and the maps, stored with the tables
+    uint64_t fingerprint();
+
 public:
     using RMFE::encode;
     using RMFE::decode;
+    using RMFE::tau;
     using RMFE::random_preimage;
 
+    /**
+     * The `Gf2RMFE` singleton, which is expected to be set up with
+     * `get_composite_gf2_rmfe64_*`. Use this to reach the NTL-free kernels.
+    */
+    static CompositeGf2RMFE64& s() {
+        return static_cast<CompositeGf2RMFE64&>(Gf2RMFE::s());
+    }
+
     /**
      * @param converter: field converter between `F_{2^{m1*m2}}` and `F_{{2^m1}^m2}`
      * @param mfe1: (k1, m1)_2 RMFE, where k1, m1 <= 64
@@ -1141,9 +1189,43 @@ public:
         g = gf2x64_to_ntl_GF2X(g_);
     }
 
-    gf2x64 encode(vec_gf2_64 h);
-    vec_gf2_64 decode(gf2x64 g);
+    gf2x64 encode(vec_gf2_64 h) {
+        if (use_lut_)
+            return lookup(encode_lut_, h);
+        return encode_slow(h);
+    }
+
+    vec_gf2_64 decode(gf2x64 g) {
+        if (use_lut_)
+            return lookup(decode_lut_, g);
+        return decode_slow(g);
+    }
+
+    /**
+     * tau = encode o decode, computed with a single table walk.
+    */
+    gf2x64 tau(gf2x64 g) {
+        if (use_lut_)
+            return lookup(tau_lut_, g);
+        return encode_slow(decode_slow(g));
+    }
+
     gf2x64 random_preimage(vec_gf2_64 h);
+
+    /// Only the lookup tables are used after this
+    void freeze();
+    void save_tables(std::ostream& o);
+    bool load_tables(std::istream& i);
+
+    /**
+     * Random preimage of `h` using caller-provided randomness `r` (only the lower m bits are used).
+     * Since tau is a projection with the same kernel as decode, `r ^ tau(r)` is uniform in the kernel
+     * of decode when `r` is uniform, and adding `encode(h)` moves it to the coset of `h`.
+    */
+    gf2x64 random_preimage(vec_gf2_64 h, gf2x64 r) {
+        r &= (m_ == 64) ? ~0ull : ((1ull << m_) - 1);
+        return encode(h) ^ r ^ tau(r);
+    }
 };
 
 /**
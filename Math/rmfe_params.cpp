@@ -0,0 +1,26 @@
+/*
+ * rmfe_params.cpp
+ *
+ */
+
+#include "rmfe_params.h"
+#include "mfe64.h"
+
+#include <iostream>
+
+std::unique_ptr<Gf2RMFE> RmfeParams::new_rmfe() const
+{
+    return get_composite_gf2_rmfe64_type1_type2(k1, k2);
+}
+
+std::unique_ptr<Gf2MFE> RmfeParams::new_mfe() const
+{
+    return get_composite_gf2_mfe64(m1, m2, m3);
+}
+
+std::ostream& operator<<(std::ostream& o, const RmfeParams& params)
+{
+    o << params.name << " ((" << params.k() << ", " << params.m()
+            << ")-RMFE, (" << params.t() << ", " << params.m() << ")-MFE)";
+    return o;
+}
@@ -0,0 +1,69 @@
+/*
+ * rmfe_params.h
+ *
+ */
+
+#ifndef MATH_RMFE_PARAMS_H_
+#define MATH_RMFE_PARAMS_H_
+
+#include <string>
+#include <memory>
+
+#include "Math/mfe.h"
+
+/**
+ * Compile-time RMFE/MFE parameter set, built as in
+ * `get_composite_gf2_rmfe64_type1_type2(K1, K2)` and
+ * `get_composite_gf2_mfe64(M1, M2, M3)`.
+ * Share types fix their widths through one of these, so the packing
+ * and field kernels are specialised for exactly one set.
+ */
+template<int K1, int K2, int M1, int M2, int M3>
+struct RmfeParamSet
+{
+    static const int k1 = K1, k2 = K2;
+    static const int m1 = M1, m2 = M2, m3 = M3;
+
+    /// number of packed bits
+    static const int k = K1 * K2;
+    /// degree of the RMFE field
+    static const int m = 4 * K1 * K2 - 2 * K2;
+    /// length of MFE encodings
+    static const int t = (2 * M1 - 1) * (2 * M2 - 1) * (2 * M3 - 1);
+
+    static_assert(M1 * M2 * M3 == m, "MFE has to work on the RMFE field");
+    static_assert(m < 64, "RMFE field has to fit a word");
+};
+
+/// Parameter set of the compiled RMFE share type
+typedef RmfeParamSet<2, 7, 2, 3, 7> DefaultRmfeParams;
+
+/**
+ * Run-time description of a compile-time parameter set, used to build
+ * the RMFE/MFE instances and to name their cache files
+ */
+class RmfeParams
+{
+public:
+    std::string name;
+    long k1, k2;
+    long m1, m2, m3;
+
+    template<class T>
+    static RmfeParams from()
+    {
+        return {std::to_string(T::k1) + "x" + std::to_string(T::k2),
+                T::k1, T::k2, T::m1, T::m2, T::m3};
+    }
+
+    long k() const { return k1 * k2; }
+    long m() const { return 4 * k1 * k2 - 2 * k2; }
+    long t() const { return (2 * m1 - 1) * (2 * m2 - 1) * (2 * m3 - 1); }
+
+    std::unique_ptr<Gf2RMFE> new_rmfe() const;
+    std::unique_ptr<Gf2MFE> new_mfe() const;
+};
+
+std::ostream& operator<<(std::ostream& o, const RmfeParams& params);
+
+#endif /* MATH_RMFE_PARAMS_H_ */
@@ -9,6 +9,7 @@
 #include "Tools/random.h"
 #include "Tools/BitVector.h"
 #include "Tools/intrinsics.h"
+#include "Tools/cpu_support.h"
 #include "Math/Square.h"
 
 union matrix16x8
@@ -154,9 +155,116 @@ const int perm[] = { 0, 8, 4, 0xc, 2, 0xa, 6, 0xe, 1, 9, 5, 0xd, 3, 0xb, 7, 0xf
 const int perm2[] = { 0, 4, 2, 6, 1, 5, 3, 7, 8, 0xc, 0xa, 0xe, 9, 0xd, 0xb, 0xf };
 #endif
 
-UNROLL_LOOPS
+#if defined(__GFNI__) && defined(__AVX512VBMI__)
+/*
+ * Transposition as 16x16 blocks of 8x8 bits: two-source byte
+ * permutations put each block into a 64-bit lane and back, and one
+ * affine transformation per lane transposes the blocks themselves.
+ */
+class gfni_transposer
+{
+    // rows r of 8 as lanes per column, half of the columns each
+    __m512i to_lanes[2];
+    // four columns of 16 rows, the latter in reverse order within 8
+    __m512i to_columns[2];
+    // four rows from 16 lanes
+    __m512i to_rows[2];
+
+public:
+    gfni_transposer()
+    {
+        for (int h = 0; h < 2; h++)
+        {
+            octet a[64], b[64], c[64];
+            for (int p = 0; p < 64; p++)
+            {
+                a[p] = 16 * (p % 8) + 8 * h + p / 8;
+                int j = 4 * h + p / 16;
+                int i = p % 16 / 8 * 8 + 7 - p % 8;
+                b[p] = (i < 8) ? 8 * j + i : 64 + 8 * j + i - 8;
+                c[p] = 8 * (p % 16) + 4 * h + p / 16;
+            }
+            to_lanes[h] = _mm512_loadu_si512(a);
+            to_columns[h] = _mm512_loadu_si512(b);
+            to_rows[h] = _mm512_loadu_si512(c);
+        }
+    }
+
+    void transpose(square128& x) const
+    {
+        // columns of bytes in row order
+        union
+        {
+            __m512i whole[16][2];
+            octet bytes[16][128];
+        } tmp;
+
+        for (int k = 0; k < 8; k++)
+        {
+            __m512i in[4], t[4];
+            for (int i = 0; i < 4; i++)
+                in[i] = _mm512_loadu_si512(&x.rows[16 * k + 4 * i]);
+            for (int i = 0; i < 4; i++)
+                t[i] = _mm512_permutex2var_epi8(in[i / 2 * 2],
+                        to_lanes[i % 2], in[i / 2 * 2 + 1]);
+            for (int i = 0; i < 4; i++)
+            {
+                __m512i out = _mm512_permutex2var_epi8(t[i / 2],
+                        to_columns[i % 2], t[2 + i / 2]);
+                // the unmasked version triggers -Wuninitialized with GCC 12
+                octet* column = tmp.bytes[4 * i] + 16 * k;
+                _mm_storeu_si128((__m128i*) column,
+                        _mm512_maskz_extracti32x4_epi32(0xF, out, 0));
+                _mm_storeu_si128((__m128i*) (column + 128),
+                        _mm512_maskz_extracti32x4_epi32(0xF, out, 1));
+                _mm_storeu_si128((__m128i*) (column + 256),
+                        _mm512_maskz_extracti32x4_epi32(0xF, out, 2));
+                _mm_storeu_si128((__m128i*) (column + 384),
+                        _mm512_maskz_extracti32x4_epi32(0xF, out, 3));
+            }
+        }
+
+        __m512i identity = _mm512_set1_epi64(0x8040201008040201);
+        for (int j = 0; j < 16; j++)
+        {
+            __m512i c[2];
+            for (int i = 0; i < 2; i++)
+                c[i] = _mm512_gf2p8affine_epi64_epi8(identity,
+                        tmp.whole[j][i], 0);
+            for (int i = 0; i < 2; i++)
+                _mm512_storeu_si512(&x.rows[8 * j + 4 * i],
+                        _mm512_permutex2var_epi8(c[0], to_rows[i], c[1]));
+        }
+    }
+};
+#endif
+
 void square128::transpose()
 {
+#if defined(__GFNI__) && defined(__AVX512VBMI__)
+    if (cpu_has_gfni() and cpu_has_avx512vbmi())
+    {
+        gfni_transpose();
+        return;
+    }
+#endif
+
+    generic_transpose();
+}
+
+void square128::gfni_transpose()
+{
+#if defined(__GFNI__) && defined(__AVX512VBMI__)
+    static const gfni_transposer transposer;
+    transposer.transpose(*this);
+#else
+    throw runtime_error("compiled without GFNI or AVX-512 VBMI");
+#endif
+}
+
+UNROLL_LOOPS
+void square128::generic_transpose()
+{
 #ifdef USE_SUBSQUARES
     for (int j = 0; j < N_SUBSQUARES; j++)
         for (int k = 0; k < j; k++)
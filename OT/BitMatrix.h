@@ -63,6 +63,9 @@ union square128 {
     void randomize(int row, PRNG& G);
     void conditional_add(BitVector& conditions, square128& other, int offset);
     void transpose();
+    // used by transpose() if the CPU supports it
+    void gfni_transpose();
+    void generic_transpose();
     template <class T>
     void to(T& result);
 
@@ -7,6 +7,7 @@
 
 #include "Math/field_types.h"
 #include "Tools/Buffer.h"
+#include "Tools/MappedBuffer.h"
 #include "Processor/InputTuple.h"
 #include "Tools/Lock.h"
 #include "Networking/Player.h"
@@ -210,10 +211,18 @@ public:
   { throw runtime_error("no normal element"); }
   virtual array<T, 5> get_quintuple(int n_bits);
   virtual array<T, 5> get_quintuple_no_count(int n_bits) { throw runtime_error("no quintuple (no count)"); }
+  /// whether the next quintuple is available without communication
+  virtual bool quintuple_buffered() { return false; }
 
   virtual void push_quintuples(const vector<array<T, 5>>&)
   { throw runtime_error("no pushing quintuples"); }
 
+  /// Generate one batch of quintuples (normal pairs) per entry in ``[begin, end)``
+  virtual void buffer_quintuple_batches(vector<vector<array<T, 5>>>&, size_t, size_t)
+  { throw runtime_error("no quintuple batches"); }
+  virtual void buffer_normal_batches(vector<vector<array<T, 2>>>&, size_t, size_t)
+  { throw runtime_error("no normal batches"); }
+
   void waste(Dtype dtype, int n = 1) 
   { usage.waste(dtype, n); }
 };
@@ -240,7 +249,10 @@ class Sub_Data_Files : public Preprocessing<T>
   map<int, EdabitPackBuffer<T>> edabitpack_buffers;
   BufferOwner<T, T> normal_buffer;
   BufferOwner<T, T> quintuple_buffer;
-  
+  // used instead of the above for regular files
+  MappedBuffer<T> normal_map;
+  MappedBuffer<T> quintuple_map;
+
 
   int my_num,num_players;
 
@@ -258,6 +270,9 @@ class Sub_Data_Files : public Preprocessing<T>
 
   edabitpack<T> get_edabitpack_no_count(bool strict, int n_bits);
 
+  bool try_map(MappedBuffer<T>& map, const BufferBase& buffer,
+      const char* data_type);
+
 public:
   static string get_filename(const Names& N, Dtype type, int thread_num = -1);
   static string get_input_filename(const Names& N, int input_player,
@@ -329,6 +344,7 @@ public:
 
   array<T, 2> get_normal_no_count();
   array<T, 5> get_quintuple_no_count(int n_bits);
+  bool quintuple_buffered() { return true; }
 };
 
 template<class sint, class sgf2n>
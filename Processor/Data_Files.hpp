@@ -490,11 +490,25 @@ void Preprocessing<T>::fill(edabitvec<T>& res, bool strict, int n_bits)
     }
 }
 
+template<class T>
+bool Sub_Data_Files<T>::try_map(MappedBuffer<T>& map, const BufferBase& buffer,
+    const char* data_type)
+{
+  if (not map.is_up() and not buffer.is_up()
+      and MappedBufferBase::mappable(buffer.get_filename()))
+    map.setup(buffer.get_filename(), data_type);
+  return map.is_up();
+}
+
 template<class T>
 array<T, 2> Sub_Data_Files<T>::get_normal_no_count() {
   array<T, 2> res;
-  normal_buffer.input(res[0]);
-  normal_buffer.input(res[1]);
+  if (try_map(normal_map, normal_buffer, "normals"))
+    for (auto& x : res)
+      normal_map.input(x);
+  else
+    for (auto& x : res)
+      normal_buffer.input(x);
   return res;
 }
 
@@ -511,11 +525,12 @@ template<class T>
 array<T, 5> Sub_Data_Files<T>::get_quintuple_no_count(int n_bits)
 {
   array<T, 5> res;
-  quintuple_buffer.input(res[0]);
-  quintuple_buffer.input(res[1]);
-  quintuple_buffer.input(res[2]);
-  quintuple_buffer.input(res[3]);
-  quintuple_buffer.input(res[4]);
+  if (try_map(quintuple_map, quintuple_buffer, "quintuples"))
+    for (auto& x : res)
+      quintuple_map.input(x);
+  else
+    for (auto& x : res)
+      quintuple_buffer.input(x);
   return res;
 }
 
@@ -256,6 +256,20 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
               *(vector<array<BT, 5>>*) job.output, job.begin, job.end);
           queues->finished(job);
         }
+      else if (job.type == QUINTUPLE_JOB)
+        {
+          Proc.DataF.DataFb.buffer_quintuple_batches(
+              *(vector<vector<array<typename sint::bit_type, 5>>>*) job.output,
+              job.begin, job.end);
+          queues->finished(job);
+        }
+      else if (job.type == NORMAL_JOB)
+        {
+          Proc.DataF.DataFb.buffer_normal_batches(
+              *(vector<vector<array<typename sint::bit_type, 2>>>*) job.output,
+              job.begin, job.end);
+          queues->finished(job);
+        }
       else if (job.type == TRIPLE_SACRIFICE_JOB)
         {
           typedef typename sint::bit_type B;
@@ -279,6 +293,11 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
                 *(Zp_Data*) job.supply);
           queues->finished(job);
         }
+      else if (job.type == PROOF_JOB)
+        {
+          (*(function<void(int, int)>*) job.output)(job.begin, job.end);
+          queues->finished(job);
+        }
       else if (job.type == CIPHER_PLAIN_MULT_JOB)
         {
           cipher_plain_mult(job, sint::triple_matmul);
@@ -35,6 +35,10 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     opening_sum = 0;
     max_broadcast = 0;
     receive_threads = false;
+    fpre_threads = 1;
+    round_size = 0;
+    rmfe_prep = "tinyot";
+    rmfe_adder = "ripple";
 #ifdef VERBOSE
     verbose = true;
 #else
@@ -109,6 +113,54 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-B", // Flag token.
             "--bucket-size" // Flag token.
     );
+    opt.add(
+            to_string(fpre_threads).c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            ("Number of threads per TinyOT triple generator (default: "
+                    + to_string(fpre_threads) + ")").c_str(), // Help description.
+            "-ft", // Flag token.
+            "--fpre-threads" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Prefix of files to cache RMFE/MFE tables (default: none)", // Help description.
+            "--rmfe-cache" // Flag token.
+    );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Multiplications per communication round in Coral "
+                    "(default: 0 for adaptive)", // Help description.
+            "--round-size" // Flag token.
+    );
+    opt.add(
+            rmfe_prep.c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            ("Source of RMFE quintuples, tinyot (conversion from TinyOT) "
+                    "or silent (OLE on Ferret, only semi-honest, needs "
+                    "-DINSECURE) (default: " + rmfe_prep
+                    + ")").c_str(), // Help description.
+            "--rmfe-prep" // Flag token.
+    );
+    opt.add(
+            rmfe_adder.c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            ("Adder for RMFE-packed edaBits, ripple (fewer multiplications) "
+                    "or kogge-stone (logarithmic rounds) (default: "
+                    + rmfe_adder + ")").c_str(), // Help description.
+            "--rmfe-adder" // Flag token.
+    );
 
     if (security)
         opt.add(
@@ -130,6 +182,27 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
     opt.get("-OF")->getString(cmd_private_output_file);
 
     opt.get("--bucket-size")->getInt(bucket_size);
+    opt.get("--fpre-threads")->getInt(fpre_threads);
+    if (fpre_threads < 1)
+        throw runtime_error("need at least one TinyOT thread");
+    opt.get("--rmfe-cache")->getString(rmfe_cache);
+    opt.get("--round-size")->getInt(round_size);
+    opt.get("--rmfe-prep")->getString(rmfe_prep);
+    if (rmfe_prep != "tinyot" and rmfe_prep != "silent")
+        throw runtime_error("unknown RMFE quintuple source: " + rmfe_prep);
+    if (rmfe_prep == "silent")
+    {
+#ifdef INSECURE
+        cerr << "RMFE QUINTUPLES FROM OLE - ONLY SEMI-HONEST SECURITY" << endl;
+#else
+        throw runtime_error("RMFE quintuples from OLE leak to a malicious OT "
+                "sender, activate them by adding -DINSECURE to the compiler "
+                "options");
+#endif
+    }
+    opt.get("--rmfe-adder")->getString(rmfe_adder);
+    if (rmfe_adder != "ripple" and rmfe_adder != "kogge-stone")
+        throw runtime_error("unknown RMFE adder: " + rmfe_adder);
 
 #ifndef VERBOSE
     verbose = opt.isSet("--verbose");
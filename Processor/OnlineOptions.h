@@ -42,6 +42,11 @@ public:
     int trunc_error;
     int opening_sum, max_broadcast;
     bool receive_threads;
+    int fpre_threads;
+    std::string rmfe_cache;
+    int round_size;
+    std::string rmfe_prep;
+    std::string rmfe_adder;
 
     OnlineOptions();
     OnlineOptions(ez::ezOptionParser& opt, int argc, const char** argv,
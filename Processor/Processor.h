@@ -37,6 +37,9 @@ class SubProcessor
   void resize(size_t size)       { C.resize(size); S.resize(size); }
 
   void check_buffering_muls(int& ii, int& jj, int i, int j, const vector<int>& reg, int size);
+  void check_pipelined_muls(int& ii, int& jj, int& fi, int& fj, int i, int j, const vector<int>& reg, int size);
+  void finalize_muls(int dest, int n);
+  void finalize_muls(const vector<int>& reg, int size, int ii, int jj, int i, int j);
 
   void check_buffering_mulrs(int& ii, int& jj, int i, int j, const vector<int>& reg);
 
@@ -488,32 +488,66 @@ void SubProcessor<T>::POpen(const Instruction& inst)
     }
 }
 
+template<class T>
+void SubProcessor<T>::finalize_muls(int dest, int n)
+{
+    if (n > 0)
+        protocol.finalize_muls(&S[dest], n);
+}
+
+/**
+ * Finalize the multiplications from ``(ii, jj)`` up to before ``(i, j)``,
+ * where the first index is the instruction and the second the vector entry
+ */
+template<class T>
+void SubProcessor<T>::finalize_muls(const vector<int>& reg, int size, int ii,
+        int jj, int i, int j)
+{
+    if (ii == i) {
+        finalize_muls(reg[3 * ii] + jj, j - jj);
+    }
+    else {
+        finalize_muls(reg[3 * ii] + jj, size - jj);
+        for (ii++; ii < i; ii++)
+            finalize_muls(reg[3 * ii], size);
+        finalize_muls(reg[3 * ii], j);
+    }
+}
+
 template<class T>
 void SubProcessor<T>::check_buffering_muls(int& ii, int& jj, int i, int j, const vector<int>& reg, int size) {
     if (protocol.get_buffer_size() >= protocol.buffer_size_per_round()) {
-        SubProcessor<T>& proc = *this;
         protocol.exchange();
-        int ii_ = ii, jj_ = jj;
-        if (ii_ == i) {
-            for (; jj_ <= j; jj_++)
-              proc.S[reg[3 * ii_] + jj_] = protocol.finalize_mul();
-        }
-        else {
-            for (; jj_ < size; jj_++)
-                proc.S[reg[3 * ii_] + jj_] = protocol.finalize_mul();
-            for (ii_++; ii_ < i; ii_++)
-                for (jj_ = 0; jj_ < size; jj_++) {
-                    proc.S[reg[3 * ii_] + jj_] = protocol.finalize_mul();
-                }
-            for (jj_ = 0; jj_ <= j; jj_++)
-                proc.S[reg[3 * ii_] + jj_] = protocol.finalize_mul();
-        }
+        finalize_muls(reg, size, ii, jj, i, j + 1);
         protocol.init_mul();
         ii = i;
         jj = j + 1;
     }
 }
 
+/**
+ * Like ``check_buffering_muls``, but the full round is only started,
+ * and the round started before is finalized while it is in flight.
+ * ``(fi, fj)`` is the end of the round in flight, ``fi < 0`` if none.
+ */
+template<class T>
+void SubProcessor<T>::check_pipelined_muls(int& ii, int& jj, int& fi, int& fj,
+        int i, int j, const vector<int>& reg, int size) {
+    if (protocol.get_buffer_size() >= protocol.buffer_size_per_round()) {
+        bool flying = fi >= 0;
+        if (flying)
+            protocol.stop_exchange();
+        protocol.start_exchange();
+        if (flying) {
+            finalize_muls(reg, size, ii, jj, fi, fj);
+            ii = fi;
+            jj = fj;
+        }
+        fi = i;
+        fj = j + 1;
+    }
+}
+
 template<class T>
 void SubProcessor<T>::buffering_muls(const vector<int>& reg, int size)
 {
@@ -522,6 +556,8 @@ void SubProcessor<T>::buffering_muls(const vector<int>& reg, int size)
 
     SubProcessor<T>& proc = *this;
     int ii = 0, jj = 0; // [zico] Represents the smallest index that has not yet been finalized
+    int fi = -1, fj = 0;
+    bool pipelined = protocol.pipelined_exchange();
     protocol.init_mul();
     for (int i = 0; i < n; i++)
         for (int j = 0; j < size; j++)
@@ -530,15 +566,31 @@ void SubProcessor<T>::buffering_muls(const vector<int>& reg, int size)
             auto& y = proc.S[reg[3 * i + 2] + j];
             protocol.prepare_mul(x, y);
 
-            check_buffering_muls(ii, jj, i, j, reg, size);
+            if (pipelined)
+                check_pipelined_muls(ii, jj, fi, fj, i, j, reg, size);
+            else
+                check_buffering_muls(ii, jj, i, j, reg, size);
         }
-    protocol.exchange();
-    for (; jj < size; jj++)
-        proc.S[reg[3 * ii] + jj] = protocol.finalize_mul();
-    for (ii++; ii < n; ii++)
-        for (jj = 0; jj < size; jj++) {
-            proc.S[reg[3 * ii] + jj] = protocol.finalize_mul();
+
+    if (pipelined)
+    {
+        if (fi >= 0)
+        {
+            protocol.stop_exchange();
+            protocol.start_exchange();
+            finalize_muls(reg, size, ii, jj, fi, fj);
+            ii = fi;
+            jj = fj;
         }
+        else
+            protocol.start_exchange();
+        protocol.stop_exchange();
+    }
+    else
+        protocol.exchange();
+    finalize_muls(reg[3 * ii] + jj, size - jj);
+    for (ii++; ii < n; ii++)
+        finalize_muls(reg[3 * ii], size);
 
     protocol.counter += n * size;
 }
@@ -565,10 +617,7 @@ void SubProcessor<T>::muls(const vector<int>& reg, int size)
         }
     protocol.exchange();
     for (int i = 0; i < n; i++)
-        for (int j = 0; j < size; j++)
-        {
-            proc.S[reg[3 * i] + j] = protocol.finalize_mul();
-        }
+        finalize_muls(reg[3 * i], size);
 
     protocol.counter += n * size;
 }
@@ -9,6 +9,8 @@
 #include "Data_Files.h"
 #include "Math/modp.h"
 
+#include <functional>
+
 enum ThreadJobType
 {
     TAPE_JOB,
@@ -21,9 +23,12 @@ enum ThreadJobType
     EDABIT_SACRIFICE_JOB,
     PERSONAL_TRIPLE_JOB,
     PERSONAL_QUINTUPLE_JOB,
+    QUINTUPLE_JOB,
+    NORMAL_JOB,
     TRIPLE_SACRIFICE_JOB,
     CHECK_JOB,
     FFT_JOB,
+    PROOF_JOB,
     CIPHER_PLAIN_MULT_JOB,
     MATRX_RAND_MULT_JOB,
     NO_JOB
@@ -165,6 +170,26 @@ public:
     }
 };
 
+class QuintupleJob : public ThreadJob
+{
+public:
+    QuintupleJob(void* batches)
+    {
+        type = QUINTUPLE_JOB;
+        output = batches;
+    }
+};
+
+class NormalJob : public ThreadJob
+{
+public:
+    NormalJob(void* batches)
+    {
+        type = NORMAL_JOB;
+        output = batches;
+    }
+};
+
 class TripleSacrificeJob : public ThreadJob
 {
 public:
@@ -198,4 +223,14 @@ public:
     }
 };
 
+class ProofJob : public ThreadJob
+{
+public:
+    ProofJob(function<void(int, int)>& batch)
+    {
+        type = PROOF_JOB;
+        output = &batch;
+    }
+};
+
 #endif /* PROCESSOR_THREADJOB_H_ */
@@ -8,10 +8,14 @@
 
 #include "SPDZ2k.h"
 #include "GC/Spdz2kBShare.h"
+#include "Tools/RoundBatcher.h"
 
 template<class T>
 class Coral : public SPDZ2k<T>
 {
+    // a triple and two openings per multiplication
+    RoundBatcher batcher;
+
 public:
     static void setup(Player& P) {
         // Use the same directory where arithmetic mac key is stored
@@ -23,12 +27,18 @@ public:
     }
 
     Coral(Player& P) :
-            SPDZ2k<T>(P)
+            SPDZ2k<T>(P), batcher(7 * sizeof(T))
     {
     }
 
+    void exchange() {
+        batcher.start(this->get_buffer_size());
+        SPDZ2k<T>::exchange();
+        batcher.stop(this->P);
+    }
+
     int buffer_size_per_round() {
-        return 1000000;
+        return batcher.size();
     }
 };
 
@@ -7,19 +7,29 @@
 #define PROTOCOLS_CORALGFP_H_
 
 #include "SPDZ.h"
+#include "Tools/RoundBatcher.h"
 
 template<class T>
 class CoralGfp : public SPDZ<T>
 {
+    // a triple and two openings per multiplication
+    RoundBatcher batcher;
+
 public:
 
     CoralGfp(Player& P) :
-            SPDZ<T>(P)
+            SPDZ<T>(P), batcher(7 * sizeof(T))
     {
     }
 
+    void exchange() {
+        batcher.start(this->get_buffer_size());
+        SPDZ<T>::exchange();
+        batcher.stop(this->P);
+    }
+
     int buffer_size_per_round() {
-        return 1000000;
+        return batcher.size();
     }
 };
 
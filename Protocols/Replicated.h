@@ -92,6 +92,8 @@ public:
     virtual T finalize_mul(int n = -1) = 0;
     /// Store next multiplication result in ``res``
     virtual void finalize_mult(T& res, int n = -1);
+    /// Store next ``n`` multiplication results in ``res``
+    virtual void finalize_muls(T* res, int n, int n_bits = -1);
 
     /// Initialize dot product round
     void init_dotprod() { init_mul(); }
@@ -133,6 +135,10 @@ public:
 
     virtual int buffer_size_per_round() { return 0; }
 
+    /// whether more multiplications can be prepared between
+    /// ``start_exchange()`` and ``stop_exchange()``
+    virtual bool pipelined_exchange() { return false; }
+
     static void setup(Player&) {}
     static void teardown() {}
 };
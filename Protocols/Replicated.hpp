@@ -134,6 +134,13 @@ void ProtocolBase<T>::finalize_mult(T& res, int n)
     res = finalize_mul(n);
 }
 
+template<class T>
+void ProtocolBase<T>::finalize_muls(T* res, int n, int n_bits)
+{
+    for (int i = 0; i < n; i++)
+        finalize_mult(res[i], n_bits);
+}
+
 template<class T>
 T ProtocolBase<T>::finalize_dotprod(int length)
 {
@@ -159,6 +159,7 @@ public:
 
     void push_quintuples(const vector<array<T, 5>>& quintuples)
     { this->quintuples.insert(this->quintuples.end(), quintuples.begin(), quintuples.end()); }
+    bool quintuple_buffered() { return not quintuples.empty(); }
 
     void shrink_to_fit();
 
@@ -8,13 +8,21 @@
 
 #include <vector>
 #include <array>
+#include <thread>
+#include <exception>
 
 #include "Replicated.h"
 #include "Processor/Data_Files.h"
 #include "Math/mfe64.h"
+#include "Math/gf2n42.h"
+#include "Math/rmfe_params.h"
 #include "TinyOT/tinyotshare.h"
 #include "TinyOT/tinyotprotocol.h"
+#include "GC/TinierSecret.h"
 #include "Protocols/ProtocolGlobalInit.h"
+#include "Tools/RoundBatcher.h"
+#include "Tools/WaitQueue.h"
+#include "GC/RmfeShareVector.h"
 
 
 template<class T> class SubProcessor;
@@ -32,11 +40,9 @@ protected:
     vector<T> shares;
     vector<typename T::open_type> opened;
     // vector<array<T, 3>> triples;
-    vector<array<T, 5>> quintuples;
     vector<int> lengths;
     typename vector<typename T::open_type>::iterator it;
     // typename vector<array<T, 3>>::iterator triple;
-    typename vector<array<T, 5>>::iterator quintuple;
     Preprocessing<T>* prep;
     typename T::MAC_Check* MC;
 
@@ -45,19 +51,81 @@ protected:
     typename vector<array<T, 2>>::iterator normal;
     typename vector<typename T::open_type>::iterator constant;
 
+    // multiplications whose masked inputs are opened together,
+    // keeping only the parts of the quintuples needed for finalization
+    struct Round
+    {
+        vector<T> shares;
+        vector<typename T::open_type> opened;
+        GC::RmfeShareVector<T> c, tau_a, tau_b;
+        vector<int> lengths;
+
+        size_t size() const { return lengths.size(); }
+
+        void clear()
+        {
+            shares.clear();
+            c.clear();
+            tau_a.clear();
+            tau_b.clear();
+            lengths.clear();
+        }
+    };
+
+    // round being prepared, round opened in the background,
+    // and round being finalized
+    Round prepared, in_flight, done;
+    // next multiplication in ``done`` to finalize
+    size_t next;
+    bool flying;
+
+    // thread opening the rounds in flight, started with the first one
+    std::thread opener;
+    WaitQueue<Round*> to_open;
+    // time taken by each round opened
+    WaitQueue<double> open_times;
+    std::exception_ptr opening_error;
+    // the round in flight has not been collected yet
+    bool opening;
+
+    // move the prepared multiplications to ``round``
+    void take_round(Round& round);
+    // returns the time taken
+    double open_round(Round& round);
+    void run_opener();
+    void finish_round();
+
+    // raw GF(2^42) words for batched finalization, kept to reuse memory
+    vector<uint64_t> masked_x, masked_y, masked_xy;
+    vector<uint64_t> res_shares, res_macs;
+
 public:
     static const bool uses_triples = true;
 
     Player& P;
 
+    // two masked inputs, two openings, and three shares in lanes
+    // per multiplication
+    RoundBatcher batcher;
+
     static void setup(Player& P);
     static void teardown();
+    /// parameter set chosen at startup, which has to match the share type
+    static const RmfeParams& params();
+    /// table cache for ``type`` if requested (``--rmfe-cache``)
+    static string cache_file(const string& type);
     static void setup_rmfe();
     static void teardown_rmfe();
     static void setup_mfe();
     static void teardown_mfe();
 
-    RmfeBeaver(Player& P) : prep(0), MC(0), P(P) {}
+    RmfeBeaver(Player& P) :
+            prep(0), MC(0), next(0), flying(false), opening(false), P(P),
+            batcher(2 * sizeof(T) + 2 * sizeof(typename T::open_type)
+                    + 6 * sizeof(uint64_t))
+    {
+    }
+    ~RmfeBeaver();
 
     typename T::Protocol branch();
 
@@ -67,6 +135,7 @@ public:
     void prepare_mul(const T& x, const T& y, int n = -1);
     void exchange();
     T finalize_mul(int n = -1);
+    void finalize_muls(T* res, int n, int n_bits = -1);
 
     void init_mul_constant();
     void prepare_mul_constant(const T& x, const typename T::clear& y, int n = -1);
@@ -75,15 +144,19 @@ public:
 
     void check();
 
+    /// Start opening the prepared multiplications in the background.
+    /// More can be prepared before ``stop_exchange()``, which makes the
+    /// started ones available for finalization.
     void start_exchange();
     void stop_exchange();
+    bool pipelined_exchange() { return true; }
 
     int get_n_relevant_players() { return 1 + T::threshold(P.num_players()); }
 
-    int get_buffer_size() { return quintuples.size(); }
+    int get_buffer_size() { return prepared.size(); }
 
     int buffer_size_per_round() {
-        return 1000000;
+        return batcher.size();
     }
 
     Player* get_player() {
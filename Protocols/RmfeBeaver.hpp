@@ -11,12 +11,21 @@
 #include "Replicated.hpp"
 #include "Tools/mpdz_ntl_types.h"
 #include "Tools/debug.h"
+#include "Processor/OnlineOptions.h"
 
 #include <array>
 
 template<class T>
 void RmfeBeaver<T>::setup(Player& P) {
-    BinaryProtocolThreadInit<TinyOTShare>::setup(P);
+    // bit triples for quintuples, from two-party TinyOT or, with more
+    // parties, from pairwise OT with Tinier
+    if (OnlineOptions::singleton.rmfe_prep == "tinyot")
+    {
+        if (P.num_players() == 2)
+            BinaryProtocolThreadInit<TinyOTShare>::setup(P);
+        else
+            BinaryProtocolThreadInit<GC::TinierSecret<gf2n_mac_key>>::setup(P);
+    }
     setup_rmfe();
     setup_mfe();
 }
@@ -24,18 +33,39 @@ void RmfeBeaver<T>::setup(Player& P) {
 template<class T>
 void RmfeBeaver<T>::teardown() {
     BinaryProtocolThreadInit<TinyOTShare>::teardown();
+    BinaryProtocolThreadInit<GC::TinierSecret<gf2n_mac_key>>::teardown();
 
     teardown_rmfe();
     teardown_mfe();
 }
 
+template<class T>
+const RmfeParams& RmfeBeaver<T>::params() {
+    typedef typename T::open_type::params compiled;
+    // The batched kernels are specialised for the compiled field.
+    static_assert(compiled::m == gf2n42::DEGREE, "wrong field for kernels");
+    static const RmfeParams res = RmfeParams::from<compiled>();
+    return res;
+}
+
+template<class T>
+string RmfeBeaver<T>::cache_file(const string& type) {
+    auto& prefix = OnlineOptions::singleton.rmfe_cache;
+    if (prefix.empty())
+        return "";
+    return prefix + "-" + params().name + "-" + type;
+}
+
 template<class T>
 void RmfeBeaver<T>::setup_rmfe() {
-    // Setup RMFE
+    // Setup RMFE, one instance shared by all threads
     if (Gf2RMFE::has_singleton())
         throw runtime_error("Can only setup RMFE once");
-    auto rmfe = get_composite_gf2_rmfe64_type1_type2(2, 7);
-    Gf2RMFE::set_singleton(std::move(rmfe));
+    auto& rmfe = Gf2RMFE::setup_shared([]() { return params().new_rmfe(); },
+            cache_file("RMFE"), params().name);
+    // The online kernels rely on the NTL-free tables of the 64-bit implementation.
+    if (!dynamic_cast<CompositeGf2RMFE64*>(&rmfe))
+        throw runtime_error("RMFE singleton must be a CompositeGf2RMFE64");
 }
 
 template<class T>
@@ -47,11 +77,11 @@ void RmfeBeaver<T>::teardown_rmfe() {
 
 template<class T>
 void RmfeBeaver<T>::setup_mfe() {
-    // Setup MFE
+    // Setup MFE, one instance shared by all threads
     if (Gf2MFE::has_singleton())
         throw runtime_error("Can only setup MFE once");
-    auto mfe = get_composite_gf2_mfe64(2, 3, 7);
-    Gf2MFE::set_singleton(std::move(mfe));
+    Gf2MFE::setup_shared([]() { return params().new_mfe(); },
+            cache_file("MFE"), params().name);
 }
 
 template<class T>
@@ -61,6 +91,19 @@ void RmfeBeaver<T>::teardown_mfe() {
     Gf2MFE::reset_singleton();
 }
 
+template<class T>
+RmfeBeaver<T>::~RmfeBeaver()
+{
+    if (opening)
+    {
+        double time;
+        open_times.pop(time);
+    }
+    to_open.stop();
+    if (opener.joinable())
+        opener.join();
+}
+
 template<class T>
 void RmfeBeaver<T>::init(Preprocessing<T>& prep, typename T::MAC_Check& MC)
 {
@@ -73,61 +116,126 @@ void RmfeBeaver<T>::init_mul()
 {
     assert(this->prep);
     assert(this->MC);
-    shares.clear();
-    opened.clear();
-    quintuples.clear();
-    lengths.clear();
+    prepared.clear();
 }
 
 template<class T>
 void RmfeBeaver<T>::prepare_mul(const T& x, const T& y, int n)
 {
     (void) n;
-    quintuples.push_back({{}});
-    auto& quintuple = quintuples.back();
-    quintuple = prep->get_quintuple(n);
+    // refilling the buffer communicates, which has to wait for the
+    // round in flight
+    if (flying and not prep->quintuple_buffered())
+        finish_round();
+
+    auto quintuple = prep->get_quintuple(n);
+
+    prepared.shares.push_back(x - quintuple[0]);
+    prepared.shares.push_back(y - quintuple[1]);
+    prepared.c.push_back(quintuple[2]);
+    prepared.tau_a.push_back(quintuple[3]);
+    prepared.tau_b.push_back(quintuple[4]);
+    prepared.lengths.push_back(n);
+}
 
-    shares.push_back(x - quintuple[0]);
-    shares.push_back(y - quintuple[1]);
-    lengths.push_back(n);
+template<class T>
+void RmfeBeaver<T>::take_round(Round& round)
+{
+    assert(prepared.shares.size() == 2 * prepared.size());
+    swap(round, prepared);
+    prepared.clear();
 }
 
 template<class T>
-void RmfeBeaver<T>::exchange()
+double RmfeBeaver<T>::open_round(Round& round)
 {
 #ifdef DETAIL_BENCHMARK
     ThreadPerformance perf(T::type_string() + " rmfebeaver exchange", P.total_comm().sent);
 #endif
 
-    assert(shares.size() == 2 * lengths.size());
-    MC->init_open(P, shares.size());
-    for (size_t i = 0; i < shares.size(); i++) {
-        MC->prepare_open(shares[i], lengths[i / 2]);
+    Timer timer;
+    timer.start();
+    MC->init_open(P, round.shares.size());
+    for (size_t i = 0; i < round.shares.size(); i++) {
+        MC->prepare_open(round.shares[i], round.lengths[i / 2]);
     }
     MC->exchange(P);
-    for (size_t i = 0; i < shares.size(); i++)
-        opened.push_back(MC->finalize_raw());
-    it = opened.begin();
-    quintuple = quintuples.begin();
+    round.opened.clear();
+    for (size_t i = 0; i < round.shares.size(); i++)
+        round.opened.push_back(MC->finalize_raw());
 
 #ifdef DETAIL_BENCHMARK
     perf.stop(P.total_comm().sent);
     GlobalPerformance::s().add(perf);
 #endif
+
+    return timer.elapsed();
+}
+
+template<class T>
+void RmfeBeaver<T>::exchange()
+{
+    assert(not flying);
+    take_round(done);
+    batcher.add(done.size(), open_round(done), P);
+    it = done.opened.begin();
+    next = 0;
+}
+
+template<class T>
+void RmfeBeaver<T>::run_opener()
+{
+    Round* round;
+    while (to_open.pop(round))
+    {
+        double time = 0;
+        try
+        {
+            time = open_round(*round);
+        }
+        catch (...)
+        {
+            opening_error = std::current_exception();
+        }
+        open_times.push(time);
+    }
 }
 
 template<class T>
 void RmfeBeaver<T>::start_exchange()
 {
-    MC->POpen_Begin(opened, shares, P);
+    assert(not flying);
+    take_round(in_flight);
+    flying = true;
+    if (not opener.joinable())
+        opener = std::thread(&RmfeBeaver<T>::run_opener, this);
+    opening = true;
+    to_open.push(&in_flight);
+}
+
+template<class T>
+void RmfeBeaver<T>::finish_round()
+{
+    if (opening)
+    {
+        double time;
+        open_times.pop(time);
+        opening = false;
+        if (opening_error)
+            std::rethrow_exception(opening_error);
+        batcher.add(in_flight.size(), time, P);
+    }
 }
 
 template<class T>
 void RmfeBeaver<T>::stop_exchange()
 {
-    MC->POpen_End(opened, shares, P);
-    it = opened.begin();
-    quintuple = quintuples.begin();
+    assert(flying);
+    finish_round();
+    flying = false;
+    swap(done, in_flight);
+    it = done.opened.begin();
+    next = 0;
 }
 
 template<class T>
@@ -138,30 +246,84 @@ T RmfeBeaver<T>::finalize_mul(int n)
 #endif
 
     (void) n;
-    typename T::open_type masked[2], norm_masked[2];
-    T& tmp = (*quintuple)[2];
-    NTL::GF2X ntl_tmp;
+    assert(next < done.size());
+    auto& rmfe = CompositeGf2RMFE64::s();
+    uint64_t x = rmfe.tau((it++)->get_word());
+    uint64_t y = rmfe.tau((it++)->get_word());
+    uint64_t xy = gf2n42::mul(x, y);
+
+    // as in finalize_muls(), on the words in the lanes
+    uint64_t share = done.c.share_lane()[next]
+            ^ gf2n42::mul(x, done.tau_b.share_lane()[next])
+            ^ gf2n42::mul(done.tau_a.share_lane()[next], y);
+    uint64_t mac = done.c.mac_lane()[next]
+            ^ gf2n42::mul(x, done.tau_b.mac_lane()[next])
+            ^ gf2n42::mul(done.tau_a.mac_lane()[next], y)
+            ^ gf2n42::mul(xy, MC->get_alphai().get_word());
+    if (P.my_num() == 0)
+        share ^= xy;
+    next++;
+
+    T tmp;
+    tmp.set_share(gf2n_short(share));
+    tmp.set_mac(gf2n_short(mac));
+
+#ifdef DETAIL_BENCHMARK
+    perf.stop(P.total_comm().sent);
+    GlobalPerformance::s().add(perf);
+#endif
+
+    return tmp;
+}
+
+/**
+ * Same as ``n`` calls to ``finalize_mul``, but computing
+ * ``c + tau(x-a) * tau_b + tau_a * tau(y-b) + tau(x-a) * tau(y-b)``
+ * on share and MAC words of the whole batch at once.
+ */
+template<class T>
+void RmfeBeaver<T>::finalize_muls(T* res, int n, int n_bits)
+{
+#ifdef DETAIL_BENCHMARK
+    ThreadPerformance perf(T::type_string() + " rmfebeaver finalize", P.total_comm().sent);
+#endif
+
+    (void) n_bits;
+    assert(done.size() - next >= size_t(n));
+    auto& rmfe = CompositeGf2RMFE64::s();
+    for (auto x : {&masked_x, &masked_y, &masked_xy, &res_shares, &res_macs})
+        x->resize(n);
 
-    for (int k = 0; k < 2; k++)
+    for (int i = 0; i < n; i++)
     {
-        masked[k] = *it++;
+        masked_x[i] = rmfe.tau((it++)->get_word());
+        masked_y[i] = rmfe.tau((it++)->get_word());
     }
-    conv(ntl_tmp, masked[0]);
-    conv(norm_masked[0], Gf2RMFE::s().tau(ntl_tmp));
-    conv(ntl_tmp, masked[1]);
-    conv(norm_masked[1], Gf2RMFE::s().tau(ntl_tmp));
 
-    tmp += (norm_masked[0] * (*quintuple)[4]);
-    tmp += ((*quintuple)[3] * norm_masked[1]);
-    tmp += T::constant(norm_masked[0] * norm_masked[1], P.my_num(), MC->get_alphai());
-    quintuple++;
+    // the quintuple parts are already in lanes
+    gf2n42::mul(masked_xy.data(), masked_x.data(), masked_y.data(), n);
+    gf2n42::fma2(res_shares.data(), done.c.share_lane() + next,
+            masked_x.data(), done.tau_b.share_lane() + next,
+            done.tau_a.share_lane() + next, masked_y.data(), n);
+    gf2n42::fma2(res_macs.data(), done.c.mac_lane() + next, masked_x.data(),
+            done.tau_b.mac_lane() + next, done.tau_a.mac_lane() + next,
+            masked_y.data(), n);
+    // MAC of the public product, overwriting the no longer needed x-a
+    gf2n42::mul(masked_x.data(), masked_xy.data(),
+            MC->get_alphai().get_word(), n);
+
+    uint64_t public_mask = P.my_num() == 0 ? ~uint64_t(0) : 0;
+    for (int i = 0; i < n; i++)
+    {
+        res[i].set_share(gf2n_short(res_shares[i] ^ (masked_xy[i] & public_mask)));
+        res[i].set_mac(gf2n_short(res_macs[i] ^ masked_x[i]));
+    }
+    next += n;
 
 #ifdef DETAIL_BENCHMARK
     perf.stop(P.total_comm().sent);
     GlobalPerformance::s().add(perf);
 #endif
-
-    return tmp;
 }
 
 template<class T>
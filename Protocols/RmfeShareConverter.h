@@ -4,6 +4,8 @@
 #include <memory>
 #include "GC/RmfeShare.h"
 #include "Protocols/ProtocolGlobalInit.h"
+#include "Tools/int.h"
+#include "Math/gf2n42.h"
 
 template<class T>
 class RmfeShareConverter {
@@ -12,6 +14,14 @@ class RmfeShareConverter {
     typedef typename GC::RmfeShare::MAC_Check DstMC;
 
 public:
+    /// Plain bits of ``RmfeShare::default_length`` consecutive shares as one word
+    static long pack(const T* shares) {
+        long res = 0;
+        for(int j = 0; j < GC::RmfeShare::default_length; j++)
+            res |= long(typename T::clear(shares[j].get_bit(0).get_share()).get_bit(0)) << j;
+        return res;
+    }
+
     SrcMC* src_mc;
     SrcLivePrep* src_prep;
 
@@ -42,6 +52,14 @@ public:
         //     GC::ShareThread<GC::RmfeShare::whole_type>::s().MC->get_alphai());
     }
 
+    /**
+     * For share types that are parts of a vector type such as ``TinierShare``,
+     * whose ShareThread singleton is the one of the vector type.
+    */
+    RmfeShareConverter(Player& P, SrcMC& src_mc, SrcLivePrep& src_prep) :
+            src_mc(&src_mc), src_prep(&src_prep), shared_prng(P) {
+    }
+
     ~RmfeShareConverter() {
     }
 
@@ -53,7 +71,15 @@ public:
         return src_mc;
     }
 
+    /// Number of random source shares consumed by one conversion
+    static int n_masks() {
+        return DIV_CEIL(40, GC::RmfeShare::default_length) * GC::RmfeShare::default_length;
+    }
+
     void convert(std::vector<GC::RmfeShare>& rmfe_shares, const std::vector<T>& src_shares);
+    /// Conversion using ``n_masks()`` random shares generated in advance
+    void convert(std::vector<GC::RmfeShare>& rmfe_shares, const std::vector<T>& src_shares,
+            const std::vector<T>& masks);
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "./RmfeShareConverter.h"
 #include "Tools/debug.h"
 #include "Tools/performance.h"
+#include "OT/BitMatrix.h"
 
 using std::vector;
 using GC::RmfeShare;
@@ -12,11 +13,21 @@ using GC::ShareThread;
 
 template<class T>
 void RmfeShareConverter<T>::convert(vector<RmfeShare>& rmfe_shares, const vector<T>& src_shares) {
+    vector<T> r(n_masks());
+    for (auto& x : r)
+        x = src_prep->get_bit();
+    convert(rmfe_shares, src_shares, r);
+}
+
+template<class T>
+void RmfeShareConverter<T>::convert(vector<RmfeShare>& rmfe_shares, const vector<T>& src_shares,
+        const vector<T>& r) {
     if (src_shares.size() % RmfeShare::default_length != 0)
         throw runtime_error("Input share batch size is not a multiple of RmfeShare packing size");
-    const int s = (40 + RmfeShare::default_length - 1) / RmfeShare::default_length;
-    int n = src_shares.size() / RmfeShare::default_length;
     int l = RmfeShare::default_length;
+    const int s = n_masks() / l;
+    int n = src_shares.size() / l;
+    assert((int) r.size() == s * l);
 
     // Construct Rmfe Input
     auto& party = ShareThread<RmfeShare::whole_type>::s();
@@ -34,29 +45,16 @@ void RmfeShareConverter<T>::convert(vector<RmfeShare>& rmfe_shares, const vector
     RmfeShare::Input input(*dst_mc, prep, P);
     input.reset_all(P);
 
-    // Get random tiny ot shares and Input to RmfeShare
-    vector<T> r(s * l);
+    // Input random tiny ot shares to RmfeShare
     for(int i = 0; i < s; i++) {
-        long raw = 0;
-        for(int j = 0; j < l; j++) {
-            int k = i * l + j;
-            // tinyot_prep->get_random_abit(r[k].MAC, r[k].KEY);
-            // raw ^= ((long) r[k].get_bit().get()) << j;
-            r[k] = src_prep->get_bit();
-            raw ^= ((long) typename T::clear(r[k].get_bit(0).get_share()).get_bit(0)) << j;
-        }
         // input.add_from_all_decoded(BitVec(raw));
-        input.add_from_all(BitVec(raw));
+        input.add_from_all(BitVec(pack(&r[i * l])));
     }
 
     // Input param tiny ot shares to RmfeShare
     for(int i = 0; i < n; i++) {
-        long raw = 0;
-        for(int j = 0; j < l; j++) {
-            raw ^= ((long) typename T::clear(src_shares[i*l + j].get_bit(0).get_share()).get_bit(0)) << j;
-        }
         // input.add_from_all_decoded(BitVec(raw));
-        input.add_from_all(BitVec(raw));
+        input.add_from_all(BitVec(pack(&src_shares[i * l])));
     }
 
     input.exchange();
@@ -64,29 +62,79 @@ void RmfeShareConverter<T>::convert(vector<RmfeShare>& rmfe_shares, const vector
     vector<RmfeShare> y(n), q(s);
     for(int i = 0; i < s + n; i++) {
         if(i < s)
-            q[i] = input.finalize(0) + input.finalize(1);
+            q[i] = input.finalize_sum();
         else
-            y[i - s] = input.finalize(0) + input.finalize(1);
+            y[i - s] = input.finalize_sum();
+    }
+
+    // Make a random linear combination with coefficient bits b[k][j][h].
+    // They are drawn as bit planes over j, one per (k, h), and transposed
+    // in 128 x 128 squares twice: once into l-bit words b[k][j] for the
+    // RMFE side, and once into s-bit indices for the source side, where
+    // index[j][h] has bit k set iff b[k][j][h] is.
+    assert(s <= 8 and s * l <= 64 and l <= 16);
+    int n_squares = DIV_CEIL(n, 128);
+    vector<uint64_t> coeffs(s * n);
+    vector<uint8_t> index(n * l);
+    square128 by_k, by_h;
+    for(int c = 0; c < n_squares; c++) {
+        by_k.set_zero();
+        by_h.set_zero();
+        for(int k = 0; k < s; k++)
+            for(int h = 0; h < l; h++)
+                by_k.rows[k * l + h] = by_h.rows[h * 8 + k] =
+                        shared_prng.get_doubleword();
+        by_k.transpose();
+        by_h.transpose();
+        for(int j = c * 128; j < min(n, (c + 1) * 128); j++) {
+            uint64_t word = *(uint64_t*) by_k.bytes[j % 128];
+            for(int k = 0; k < s; k++)
+                coeffs[k * n + j] = (word >> (k * l)) & ((1ULL << l) - 1);
+            memcpy(&index[j * l], by_h.bytes[j % 128], l);
+        }
+    }
+
+    // On the RMFE side, each combination is an inner product in GF(2^42)
+    // with the encoded coefficients, computed on raw share and MAC words.
+    auto& rmfe = CompositeGf2RMFE64::s();
+    vector<uint64_t> y_shares(n), y_macs(n), encoded(n);
+    for(int j = 0; j < n; j++) {
+        y_shares[j] = y[j].get_share().get_word();
+        y_macs[j] = y[j].get_mac().get_word();
     }
 
-    // Make a random linear combination
     vector<RmfeShare> z_share(s);
     vector<RmfeShare::open_type> z(s);
+    for(int k = 0; k < s; k++) {
+        const uint64_t* b = &coeffs[k * n];
+        for(int j = 0; j < n; j++)
+            encoded[j] = rmfe.encode(b[j]);
+        RmfeShare sum;
+        sum.set_share(gf2n_short(gf2n42::dot(y_shares.data(), encoded.data(), n)));
+        sum.set_mac(gf2n_short(gf2n42::dot(y_macs.data(), encoded.data(), n)));
+        z_share[k] = q[k] + sum;
+    }
+
+    // On the source side, all s combinations of slot h are computed at once
+    // by summing each share into the bucket of its index, after which
+    // combination k is the sum of the buckets with bit k set.
+    T zero = src_shares.at(0) * false;
+    vector<T> buckets(l << s, zero);
+    for(int j = 0; j < n; j++) {
+        const T* src = &src_shares[j * l];
+        const uint8_t* idx = &index[j * l];
+        for(int h = 0; h < l; h++)
+            buckets[(h << s) + idx[h]] += src[h];
+    }
     vector<T> z_prime_share(s * l);
     vector<typename T::open_type> z_prime(s * l);
-    for(int k = 0; k < s; k++) {
-        z_share[k] = q[k];
-        for(int j = 0; j < n; j++) {
-            RmfeShare::raw_type b = shared_prng.get<RmfeShare::raw_type>();
-            z_share[k] += y[j] * RmfeShare::open_type(b);
-
-            for(int h = 0; h < l; h++) {
-                if (j == 0)
-                    z_prime_share[k * l + h] = r[k * l + h];
-                z_prime_share[k * l + h] += src_shares[j * l + h] * b.get_bit(h);
-            }
+    for(int k = 0; k < s; k++)
+        for(int h = 0; h < l; h++) {
+            T& z_prime_kh = z_prime_share[k * l + h];
+            z_prime_kh = r[k * l + h];
+            for(int i = 1 << k; i < (1 << s); i = (i + 1) | (1 << k))
+                z_prime_kh += buckets[(h << s) + i];
         }
-    }
     dst_mc->POpen(z, z_share, P);
     src_mc->POpen(z_prime, z_prime_share, P);
 
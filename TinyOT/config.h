@@ -1,6 +1,7 @@
 #ifndef EMP_AG2PC_CONFIG_H__
 #define EMP_AG2PC_CONFIG_H__
 namespace emp {
+// default number of Fpre worker threads, see OnlineOptions::fpre_threads
 const static int fpre_threads = 1;
 const static char * IP = "127.0.0.1";
 //const static char * IP = "172.31.10.128";
@@ -20,20 +20,23 @@
 namespace emp {
 //#define __debug
 
-inline string get_ferret_filename(int my_num, int other_num, bool send, int thread_num)
+inline string get_ferret_filename(int my_num, int other_num, bool send, int thread_num,
+		int fpre_thread = 0)
 {
 	if (mkdir_p("Player-Data/TinyOT/") < 0)
     	throw file_error("cannot create directory Player-Data/TinyOT/");
     return "Player-Data/TinyOT/Ferret-P" + std::to_string(my_num)
             + "-" + std::to_string(other_num) + "-" + (send? "Send" : "Recv") 
-			+ (thread_num >= 0? "-T" + std::to_string(thread_num) : "");
+			+ (thread_num >= 0? "-T" + std::to_string(thread_num) : "")
+			+ (fpre_thread > 0? "-F" + std::to_string(fpre_thread) : "");
 }
 
 template<typename T>
 class Fpre {
 	public:
 		ThreadPool *pool;
-		const static int THDS = fpre_threads;
+		// number of worker threads, each with its own channels and Ferret instances
+		const int THDS;
 		int batch_size = 0, bucket_size = 0, size = 0;
 		int party;
 		block * keys = nullptr;
@@ -41,8 +44,8 @@ class Fpre {
 		PRG prg;
 		PRP prp;
 		PRP *prps;
-		T *io[THDS];
-		T *io2[THDS];
+		vector<T*> io;
+		vector<T*> io2;
 		int bandwidth() {
 			int sum = 0;
 			for(int i = 0; i < THDS; ++i) {
@@ -51,20 +54,25 @@ class Fpre {
 			}
 			return sum;
 		}
-		LeakyDeltaOT<T> *abit1[THDS], *abit2[THDS];
+		vector<LeakyDeltaOT<T>*> abit1, abit2;
 		block Delta;
 		block ZDelta;
 		block one;
-		Feq<T> *eq[THDS*2];
+		vector<Feq<T>*> eq;
 		block * MAC = nullptr, *KEY = nullptr;
 		block * MAC_res = nullptr, *KEY_res = nullptr;
 		block * pretable = nullptr;
 
-		TwoPartyPlayer * players[THDS];
-		TwoPartyPlayer * players2[THDS];
+		vector<TwoPartyPlayer*> players;
+		vector<TwoPartyPlayer*> players2;
 
-		Fpre(T * in_io, int in_party, int bsize = 1000, int thread_id = -1) {
-			assert(THDS == 1);
+		Fpre(T * in_io, int in_party, int bsize = 1000, int thread_id = -1,
+				int n_threads = fpre_threads) :
+				THDS(n_threads), io(n_threads), io2(n_threads),
+				abit1(n_threads), abit2(n_threads), eq(2 * n_threads),
+				players(n_threads), players2(n_threads) {
+			if (THDS < 1)
+				throw runtime_error("need at least one Fpre thread");
 			pool = new ThreadPool(THDS*2);
 			prps = new PRP[THDS*2];
 			this->party = in_party;
@@ -86,25 +94,32 @@ class Fpre {
 				eq[THDS+i] = new Feq<T>(io2[i], party);
 			}
 
-			string pre_file1 = get_ferret_filename(in_party, 3-in_party, in_party == emp::ALICE, thread_id);
-			abit1[0] = new LeakyDeltaOT<T>(in_party, io[0]);
-			string pre_file2 = get_ferret_filename(in_party, 3-in_party, in_party == emp::BOB, thread_id);
-			abit2[0] = new LeakyDeltaOT<T>(3 - in_party, io2[0]);
-
 			bool tmp_s[128];
 			prg.random_bool(tmp_s, 128);
 			tmp_s[0] = true;
-			if(party == ALICE) {
-				tmp_s[1] = true;
-				abit1[0]->setup_send(bool_to_block(tmp_s), pre_file1);
-				io[0]->flush();
-				abit2[0]->setup_recv(pre_file2);
-			} else {
-				tmp_s[1] = false;
-				abit1[0]->setup_recv(pre_file1);
-				io[0]->flush();
-				abit2[0]->setup_send(bool_to_block(tmp_s), pre_file2);
+			tmp_s[1] = party == ALICE;
+			// all threads share the same Delta so that their outputs can be
+			// combined, but each runs its own Ferret instance and base OTs
+			block delta_s = bool_to_block(tmp_s);
+			vector<future<void>> res;
+			for(int i = 0; i < THDS; ++i) {
+				res.push_back(pool->enqueue([this, in_party, thread_id, delta_s, i](){
+					string pre_file1 = get_ferret_filename(in_party, 3-in_party, in_party == emp::ALICE, thread_id, i);
+					abit1[i] = new LeakyDeltaOT<T>(in_party, io[i]);
+					string pre_file2 = get_ferret_filename(in_party, 3-in_party, in_party == emp::BOB, thread_id, i);
+					abit2[i] = new LeakyDeltaOT<T>(3 - in_party, io2[i]);
+					if(party == ALICE) {
+						abit1[i]->setup_send(delta_s, pre_file1);
+						io[i]->flush();
+						abit2[i]->setup_recv(pre_file2);
+					} else {
+						abit1[i]->setup_recv(pre_file1);
+						io[i]->flush();
+						abit2[i]->setup_send(delta_s, pre_file2);
+					}
+				}));
 			}
+			joinNclean(res);
 
 			if(party == ALICE) Delta = abit1[0]->Delta();
 			else Delta = abit2[0]->Delta();
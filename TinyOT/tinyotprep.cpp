@@ -19,7 +19,10 @@ BufferTinyOTPrep::BufferTinyOTPrep(DataPositions& usage, int batch_size) :
 
 void BufferTinyOTPrep::set_protocol(TinyOTShare::Protocol& protocol) {
 	this->P = &protocol.P;
-	// [zico] Assuming 2pc, so the other player's number is (1 - my_num)
+	// TinyOT is a two-party protocol, RmfeSharePrep uses Tinier for more parties
+	if (this->P->num_players() != 2)
+		throw runtime_error("TinyOT preprocessing only supports two parties, "
+				"not " + to_string(this->P->num_players()));
 	player_2pc = new RealTwoPartyPlayerWithStats(*(this->P), 1 - this->P->my_num(), this->P->get_id() + "-TinyOT");
 	// [zico] might need to update IP here according to MP SPDZ's configuration
 	io = new EmpChannel(player_2pc);
@@ -32,7 +35,8 @@ void BufferTinyOTPrep::set_batch_size(int batch_size) {
 		fpre->set_batch_size(batch_size);
 	else  {
 #ifdef USE_SILENT_OT
-		fpre = new emp::Fpre<EmpChannel>(io, this->P->my_num() + 1, batch_size, BaseMachine::thread_num);
+		fpre = new emp::Fpre<EmpChannel>(io, this->P->my_num() + 1, batch_size, BaseMachine::thread_num,
+				OnlineOptions::singleton.fpre_threads);
 #else
 		fpre = new emp::Fpre<EmpChannel>(io, this->P->my_num() + 1, batch_size);
 #endif
@@ -81,6 +85,14 @@ void BufferTinyOTPrep::get_tinyot_triple(
 	triple_buf_idx++;
 }
 
+bool BufferTinyOTPrep::both_continue(bool go) {
+	assert(io != nullptr);
+	char mine = go, theirs;
+	io->send_data(&mine, 1);
+	io->recv_data(&theirs, 1);
+	return go and theirs;
+}
+
 BufferTinyOTPrep::~BufferTinyOTPrep() {
 	if (io)
 		delete io;
@@ -47,6 +47,14 @@ public:
 	void get_tinyot_triple(emp::block& aMAC, emp::block& aKEY,
 		emp::block& bMAC, emp::block& bKEY,
 		emp::block& cMAC, emp::block& cKEY);
+
+	void get_three_no_count(Dtype, TinyOTShare& a, TinyOTShare& b, TinyOTShare& c) {
+		get_tinyot_triple(a.MAC, a.KEY, b.MAC, b.KEY, c.MAC, c.KEY);
+	}
+
+	// Whether both parties want to go on, on the same channel as the triples
+	bool both_continue(bool go);
+
 	~BufferTinyOTPrep();
 };
 
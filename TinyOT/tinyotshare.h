@@ -100,13 +100,9 @@ public:
 	}
 
 	void mul(const TinyOTShare& S,const bool& c) {
-		if (c) {
-			*this = S;
-		}
-		else {
-			this->MAC = emp::zero_block;
-			this->KEY = emp::zero_block;
-		}
+		// branch-free, as used in random linear combinations
+		this->MAC = S.MAC & emp::select_mask[c];
+		this->KEY = S.KEY & emp::select_mask[c];
 	}
    	void add(const TinyOTShare& S1, const TinyOTShare& S2) {
 		this->MAC = S1.MAC ^ S2.MAC;
@@ -45,7 +45,7 @@ public:
     void setup(ifstream* f, int length, const string& filename,
             const char* type = "", const string& field = {});
     void seekg(int pos);
-    bool is_up() { return file != 0; }
+    bool is_up() const { return file != 0; }
     bool is_pipe();
     void try_rewind();
     void prune();
@@ -42,6 +42,7 @@ class ReceivedMsg : public virtual FlexBuffer
 
 public:
 	void operator=(FlexBuffer& msg) { FlexBuffer::operator=(msg); }
+	void operator=(octetStream& os) { FlexBuffer::operator=(os); }
 	void reset_head() { ptr = buf; }
 	void resize(size_t new_len);
 	void unserialize(void* output, size_t size);
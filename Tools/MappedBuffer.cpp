@@ -0,0 +1,91 @@
+/*
+ * MappedBuffer.cpp
+ *
+ */
+
+#include "MappedBuffer.h"
+#include "Tools/Exceptions.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+bool MappedBufferBase::mappable(const string& filename)
+{
+    struct stat buf;
+    return stat(filename.c_str(), &buf) == 0 and S_ISREG(buf.st_mode);
+}
+
+void MappedBufferBase::map(const string& filename, const octetStream& signature)
+{
+    unmap();
+    this->filename = filename;
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw file_error("cannot open " + filename);
+    struct stat buf;
+    if (fstat(fd, &buf) != 0)
+    {
+        close(fd);
+        throw file_error("cannot stat " + filename);
+    }
+    file_size = buf.st_size;
+    if (file_size < sizeof(size_t))
+    {
+        close(fd);
+        throw signature_mismatch(filename);
+    }
+    void* res = mmap(0, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (res == MAP_FAILED)
+        throw file_error("cannot map " + filename);
+    data = (const char*) res;
+    madvise(res, file_size, MADV_SEQUENTIAL);
+
+    // same layout as octetStream::output()
+    size_t length = *(const size_t*) data;
+    header_length = sizeof(length) + length;
+    if (header_length > file_size or length != signature.get_length()
+            or memcmp(data + sizeof(length), signature.get_data(), length))
+    {
+        unmap();
+        throw signature_mismatch(filename);
+    }
+    pos = header_length;
+}
+
+void MappedBufferBase::unmap()
+{
+    if (data)
+        munmap((void*) data, file_size);
+    data = 0;
+    file_size = pos = header_length = 0;
+}
+
+const char* MappedBufferBase::next(size_t length)
+{
+    if (not data)
+        throw file_error(filename + " not mapped");
+    if (left() < length)
+    {
+#ifdef INSECURE
+        if (file_size - header_length >= length)
+        {
+            cerr << "REUSING DATA FROM " << filename
+                    << " - ONLY FOR BENCHMARKING" << endl;
+            pos = header_length;
+            return next(length);
+        }
+#endif
+        string type;
+        if (data_type.size())
+            type = " of " + data_type;
+        throw not_enough_to_buffer(type, filename);
+    }
+    auto res = data + pos;
+    pos += length;
+    return res;
+}
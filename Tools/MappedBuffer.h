@@ -0,0 +1,86 @@
+/*
+ * MappedBuffer.h
+ *
+ */
+
+#ifndef TOOLS_MAPPEDBUFFER_H_
+#define TOOLS_MAPPEDBUFFER_H_
+
+#include <string>
+using namespace std;
+
+#include "Tools/Buffer.h"
+
+/**
+ * Read-only memory mapping of a preprocessing file with the header
+ * written by ``file_signature()``, avoiding copies through ``ifstream``
+ */
+class MappedBufferBase
+{
+protected:
+    const char* data;
+    size_t file_size;
+    size_t header_length;
+    size_t pos;
+    string filename;
+    string data_type;
+
+    void map(const string& filename, const octetStream& signature);
+    void unmap();
+
+public:
+    MappedBufferBase() :
+            data(0), file_size(0), header_length(0), pos(0)
+    {
+    }
+    MappedBufferBase(const MappedBufferBase& other) :
+            MappedBufferBase()
+    {
+        assert(not other.data);
+    }
+    ~MappedBufferBase()
+    {
+        unmap();
+    }
+    MappedBufferBase& operator=(const MappedBufferBase&) = delete;
+
+    /// Whether ``filename`` can be mapped (a regular file, not a pipe)
+    static bool mappable(const string& filename);
+
+    bool is_up() const
+    {
+        return data != 0;
+    }
+
+    /// Number of bytes not consumed yet
+    size_t left() const
+    {
+        return file_size - pos;
+    }
+
+    const char* next(size_t length);
+};
+
+template<class T>
+class MappedBuffer : public MappedBufferBase
+{
+public:
+    void setup(const string& filename, const char* data_type = "")
+    {
+        this->data_type = data_type;
+        map(filename, file_signature<T>());
+    }
+
+    /// Number of elements not consumed yet
+    size_t size() const
+    {
+        return left() / T::size();
+    }
+
+    void input(T& a)
+    {
+        a.assign(next(T::size()));
+    }
+};
+
+#endif /* TOOLS_MAPPEDBUFFER_H_ */
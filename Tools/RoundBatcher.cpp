@@ -0,0 +1,91 @@
+/*
+ * RoundBatcher.cpp
+ *
+ */
+
+#include "RoundBatcher.h"
+#include "Processor/OnlineOptions.h"
+
+#include <unistd.h>
+#include <limits.h>
+#include <algorithm>
+
+RoundBatcher::RoundBatcher(size_t item_memory) :
+        s1(0), sx(0), sy(0), sxx(0), sxy(0), n_rounds(0), n_items(0)
+{
+    int round_size = OnlineOptions::singleton.round_size;
+    fixed = round_size > 0;
+    size_ = fixed ? round_size : 1 << 16;
+
+    // use at most a quarter of the free memory
+    double max_items = INT_MAX / 2;
+#ifdef _SC_AVPHYS_PAGES
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    if (pages > 0)
+        max_items = min(max_items, double(pages) * sysconf(_SC_PAGESIZE) / 4
+                / max(item_memory, size_t(1)));
+#endif
+    // only bounds the proposals because the parties have to start alike
+    max_size = max(double(min_size), max_items);
+}
+
+void RoundBatcher::start(size_t n_items)
+{
+    this->n_items = n_items;
+    timer.reset();
+    timer.start();
+}
+
+void RoundBatcher::stop(const Player& P)
+{
+    timer.stop();
+    add(n_items, timer.elapsed(), P);
+}
+
+void RoundBatcher::add(size_t n_items, double seconds, const Player& P)
+{
+    if (fixed)
+        return;
+
+    const double decay = 0.9;
+    double x = n_items, y = seconds;
+    s1 = decay * s1 + 1;
+    sx = decay * sx + x;
+    sy = decay * sy + y;
+    sxx = decay * sxx + x * x;
+    sxy = decay * sxy + x * y;
+
+    if (++n_rounds % sync_interval == 0)
+        sync(P);
+}
+
+int RoundBatcher::propose()
+{
+    double var = s1 * sxx - sx * sx;
+    double proposal = 2. * size_;
+    if (var > 1e-6 * s1 * sxx)
+    {
+        double per_item = (s1 * sxy - sx * sy) / var;
+        double rtt = (sy - per_item * sx) / s1;
+        if (per_item > 0 and rtt > 0)
+            proposal = 9 * rtt / per_item;
+    }
+    proposal = min(proposal, 4. * size_);
+    proposal = max(proposal, size_ / 4.);
+    return max(double(min_size), min(double(max_size), proposal));
+}
+
+void RoundBatcher::sync(const Player& P)
+{
+    vector<octetStream> os(P.num_players());
+    os[P.my_num()].store(propose());
+    P.Broadcast_Receive(os);
+    int res = INT_MAX;
+    for (auto& o : os)
+    {
+        int proposal;
+        o.get(proposal);
+        res = min(res, proposal);
+    }
+    size_ = res;
+}
@@ -0,0 +1,56 @@
+/*
+ * RoundBatcher.h
+ *
+ */
+
+#ifndef TOOLS_ROUNDBATCHER_H_
+#define TOOLS_ROUNDBATCHER_H_
+
+#include "Networking/Player.h"
+#include "Tools/time-func.h"
+
+/**
+ * Number of buffered multiplications per communication round
+ * (``buffer_size_per_round()``), adapted to the measured cost of rounds.
+ *
+ * The time of every round is fitted as ``rtt + n * per_item`` with
+ * exponentially decaying weights, and the size is chosen such that the
+ * fixed cost is about a tenth of a round. All parties have to flush at
+ * the same points, so they start with the same size, and the size only
+ * changes every ``sync_interval`` rounds, to the minimum of all
+ * proposals, each of which is bounded by the available memory of its
+ * party. A positive ``--round-size`` fixes the size instead.
+ */
+class RoundBatcher
+{
+    static const int sync_interval = 16;
+    static const int min_size = 1 << 10;
+
+    int size_, max_size;
+    bool fixed;
+
+    // weighted sums for the least-squares fit
+    double s1, sx, sy, sxx, sxy;
+    int n_rounds;
+
+    Timer timer;
+    size_t n_items;
+
+    int propose();
+    void sync(const Player& P);
+
+public:
+    /// ``item_memory`` is the number of bytes buffered per item
+    RoundBatcher(size_t item_memory);
+
+    int size() const { return size_; }
+
+    /// call before a round with ``n_items`` items
+    void start(size_t n_items);
+    /// call after the round, synchronizes the size if due
+    void stop(const Player& P);
+    /// record a round timed elsewhere, synchronizes the size if due
+    void add(size_t n_items, double seconds, const Player& P);
+};
+
+#endif /* TOOLS_ROUNDBATCHER_H_ */
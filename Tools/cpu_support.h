@@ -67,6 +67,42 @@ inline bool cpu_has_pclmul()
 #endif
 }
 
+inline bool cpu_has_vpclmul()
+{
+#ifdef CHECK_VPCLMUL
+    return check_cpu(7, true, 10);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_avx512f()
+{
+#ifdef CHECK_AVX512F
+    return check_cpu(7, false, 16);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_avx512vbmi()
+{
+#ifdef CHECK_AVX512VBMI
+    return check_cpu(7, true, 1);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_gfni()
+{
+#ifdef CHECK_GFNI
+    return check_cpu(7, true, 8);
+#else
+    return true;
+#endif
+}
+
 inline bool cpu_has_aes()
 {
 #ifdef CHECK_AES
@@ -43,6 +43,40 @@
 #include "Tools/performance.h"
 
 string buffer_type = "inputs";
+long long n_per_thread = 0;
+
+/**
+ * Write RMFE quintuples and normal pairs in the format read by
+ * ``Sub_Data_Files`` (e.g., ``coral-party.x -F``)
+ */
+template<class T>
+long long write_prep_files(Preprocessing<T>& prep, const Player& P, int thread_num,
+        long long n)
+{
+    string dir = get_prep_sub_dir<T>(PREP_DIR, P.num_players(), true);
+    string quintuple_file = PrepBase::get_quintuple_filename(dir, T::type_short(),
+            P.my_num(), thread_num);
+    string normal_file = PrepBase::get_normal_filename(dir, T::type_short(),
+            P.my_num(), thread_num);
+    ofstream quintuples(quintuple_file, ios::out | ios::binary);
+    ofstream normals(normal_file, ios::out | ios::binary);
+    file_signature<T>().output(quintuples);
+    file_signature<T>().output(normals);
+    for (long long i = 0; i < n; i++)
+    {
+        for (auto& x : prep.get_quintuple_no_count(T::default_length))
+            x.output(quintuples, false);
+        for (auto& x : prep.get_normal_no_count())
+            x.output(normals, false);
+    }
+    if (quintuples.fail())
+        throw file_error(quintuple_file);
+    if (normals.fail())
+        throw file_error(normal_file);
+    cout << "Wrote " << n << " quintuples to " << quintuple_file << " and "
+            << n << " normal pairs to " << normal_file << endl;
+    return n;
+}
 
 class PrepThread {
 public:
@@ -83,9 +117,11 @@ class BinaryPrepThread : public PrepThread
 {
 public:
     Player* P;
+    int thread_num;
 
     BinaryPrepThread(const Names& names, int thread_num) 
-        : P(new PlainPlayer(names, "thread" + to_string(thread_num))) {
+        : P(new PlainPlayer(names, "thread" + to_string(thread_num))),
+          thread_num(thread_num) {
     }
 
     void generate() {
@@ -110,6 +146,11 @@ public:
             generated = prep->get_triples_size() * T::default_length;
             cout << "Generated: " << generated << " triples" << endl;
         }
+        else if (buffer_type == "files") {
+            generated = write_prep_files(*prep, *P,
+                    OnlineOptions::singleton.file_prep_per_thread ? thread_num : -1,
+                    n_per_thread) * T::default_length;
+        }
         else if (buffer_type == "crypto2022"){
             prep->buffer_crypto2022_quintuples();
             generated = prep->get_triples_size() * T::default_length;
@@ -166,13 +207,28 @@ BinaryOfflineMachine::BinaryOfflineMachine(int argc, const char** argv) :
         0, // Required?
         1, // Number of args expected.
         0, // Delimiter if expecting multiple args.
-        "Buffer type (inputs, triples, crypto2022)", // Help description.
+        "Buffer type (inputs, triples, crypto2022, files)\n\t"
+        "files: write -n quintuples and normal pairs to Player-Data (coral only)", // Help description.
         "-type", // Flag token.
         "--type" // Flag token.
     );
 
+    opt.add(
+        "1", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "Number of threads per TinyOT triple generator (default: 1)", // Help description.
+        "-ft", // Flag token.
+        "--fpre-threads" // Flag token.
+    );
+
     parse_options(argc, argv);
 
+    opt.get("--fpre-threads")->getInt(OnlineOptions::singleton.fpre_threads);
+    if (OnlineOptions::singleton.fpre_threads < 1)
+        throw runtime_error("need at least one TinyOT thread");
+
     if (opt.isSet("--type"))
     {
         opt.get("--type")->getString(buffer_type);
@@ -189,6 +245,15 @@ BinaryOfflineMachine::BinaryOfflineMachine(int argc, const char** argv) :
     
     if (prot == "crypto2022")
         buffer_type = "crypto2022";
+
+    if (buffer_type == "files")
+    {
+        if (prot != "coral")
+            throw runtime_error("can only write files for coral");
+        // one set of files per thread, to be read with -f
+        OnlineOptions::singleton.file_prep_per_thread = nthreads > 1;
+        n_per_thread = nTriplesPerThread;
+    }
 }
 
 template<class T>
@@ -199,7 +264,8 @@ BinaryPrepThread<T>* BinaryOfflineMachine::new_generator(int i)
 
 void BinaryOfflineMachine::run()
 {
-    cout << "my_num: " << my_num << ", nthreads: " << nthreads << ", batch size: " << OnlineOptions::singleton.batch_size << endl;
+    cout << "my_num: " << my_num << ", nthreads: " << nthreads << ", batch size: " << OnlineOptions::singleton.batch_size
+        << ", fpre threads: " << OnlineOptions::singleton.fpre_threads << endl;
     network_opts.start_networking(N[0], my_num);
     nConnections = 1;
 
@@ -68,6 +68,18 @@ queues->finished({});
               *(vector<array<sint::bit_type, 5>>*) job.output, job.begin, job.end);
           queues->finished(job);
         }
+        else if (job.type == QUINTUPLE_JOB)
+        {
+          bit_prep.buffer_quintuple_batches(
+              *(vector<vector<array<sint::bit_type, 5>>>*) job.output, job.begin, job.end);
+          queues->finished(job);
+        }
+        else if (job.type == NORMAL_JOB)
+        {
+          bit_prep.buffer_normal_batches(
+              *(vector<vector<array<sint::bit_type, 2>>>*) job.output, job.begin, job.end);
+          queues->finished(job);
+        }
     }
 delete subproc;
 delete MCp;
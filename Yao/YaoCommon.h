@@ -28,6 +28,7 @@ class YaoCommon : public GC::RuntimeBranching
 public:
     static const int DONE = -1;
     static const int MORE = -2;
+    static const int CHUNK = -3;
 
     long counter;
 
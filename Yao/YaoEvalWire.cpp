@@ -45,6 +45,7 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 	}
 
 	processor.complexity += total;
+	party.ensure_gates(total * sizeof(YaoGate));
 	int i_thread = 0, start = 0;
 	for (auto& x : party.get_splits(args, threshold, total))
 	{
@@ -69,6 +70,7 @@ void YaoEvalWire::and_singlethread(GC::Processor<GC::Secret<YaoEvalWire> >& proc
 	processor.complexity += total_ands;
 	size_t n_args = args.size();
 	YaoEvaluator& party = YaoEvaluator::s();
+	party.ensure_gates(total_ands * sizeof(YaoGate));
 	YaoGate* gate = (YaoGate*) party.gates.consume(total_ands * sizeof(YaoGate));
 	long counter = party.get_gate_id();
 	map<string, Timer> timers;
@@ -194,7 +196,7 @@ void YaoEvalWire::op(const YaoEvalWire& left, const YaoEvalWire& right,
 bool YaoEvalWire::get_output()
 {
 	YaoEvaluator::s().taint();
-	bool res = external() ^ YaoEvaluator::s().output_masks.pop_front();
+	bool res = external() ^ YaoEvaluator::s().pop_output_mask();
 #ifdef DEBUG
     cout << "output " << res << " mask " << (external() ^ res) << " external() "
             << external() << endl;
@@ -21,38 +21,64 @@ YaoEvaluator::YaoEvaluator(int thread_num, YaoEvalMaster& master) :
 		YaoCommon<YaoEvalWire>(master),
 		master(master),
 		player(N, 0, "thread" + to_string(thread_num)),
-		ot_ext(OTExtensionWithMatrix::setup(player, {}, RECEIVER, true))
+		ot_ext(OTExtensionWithMatrix::setup(player, {}, RECEIVER, true)),
+		gate_player(0), segment_received(false)
 {
 	set_n_program_threads(master.machine.nthreads);
 	this->init(*this);
+	if (continuous())
+	{
+		gate_player = new RealTwoPartyPlayer(N, 0,
+				"gates" + to_string(thread_num));
+		chunks.resize(N_CHUNKS);
+		for (auto& chunk : chunks)
+			free_chunks.push(&chunk);
+	}
+}
+
+YaoEvaluator::~YaoEvaluator()
+{
+	// the receiver might still wait for a free chunk after an error
+	free_chunks.stop();
+	if (receiver.joinable())
+		receiver.join();
+	if (gate_player)
+		delete gate_player;
 }
 
 void YaoEvaluator::pre_run()
 {
 	if (master.opts.cmd_private_output_file.empty())
 		processor.out.activate(not continuous());
-	if (not continuous())
+	if (continuous())
+		receiver = thread(&YaoEvaluator::receive_gates, this);
+	else
 		receive_to_store(*P);
 }
 
+void YaoEvaluator::post_run()
+{
+	if (receiver.joinable())
+		receiver.join();
+}
+
 void YaoEvaluator::run(GC::Program& program)
 {
 	singleton = this;
 
 	if (continuous())
-		run(program, *P);
+		run_streaming(program);
 	else
 	{
 		run_from_store(program);
 	}
 }
 
-void YaoEvaluator::run(GC::Program& program, Player& P)
+void YaoEvaluator::run_streaming(GC::Program& program)
 {
 	auto next = GC::TIME_BREAK;
 	do
 	{
-		receive(P);
 		try
 		{
 			next = program.execute(processor, master.memory, -1);
@@ -60,6 +86,7 @@ void YaoEvaluator::run(GC::Program& program, Player& P)
 		catch (needs_cleaning& e)
 		{
 		}
+		finish_segment();
 	}
 	while(GC::DONE_BREAK != next);
 }
@@ -100,3 +127,75 @@ void YaoEvaluator::receive_to_store(Player& P)
 		output_masks_store.push(output_masks);
 	}
 }
+
+void YaoEvaluator::receive_gates()
+{
+	int tag;
+	try
+	{
+		do
+		{
+			YaoGateChunk* chunk;
+			// stopped by the destructor
+			if (not free_chunks.pop(chunk))
+				return;
+			octetStream header;
+			gate_player->receive(header);
+			header.get(tag);
+			chunk->tag = tag;
+			if (tag != YaoCommon::DONE)
+			{
+				octetStream os;
+				gate_player->receive(os);
+				chunk->gates = os;
+				if (tag == YaoCommon::MORE)
+				{
+					octetStream masks;
+					gate_player->receive(masks);
+					chunk->output_masks = masks;
+				}
+			}
+			full_chunks.push(chunk);
+		}
+		while (tag != YaoCommon::DONE);
+	}
+	catch (...)
+	{
+		// rethrown by the main thread when it runs out of chunks
+		receive_error = current_exception();
+		full_chunks.stop();
+	}
+}
+
+void YaoEvaluator::receive_chunk()
+{
+	if (gates.left() != 0)
+		throw runtime_error("garbled tables out of sync");
+
+	YaoGateChunk* chunk;
+	if (not full_chunks.pop(chunk))
+		rethrow_exception(receive_error);
+	switch (chunk->tag)
+	{
+	case YaoCommon::DONE:
+		throw runtime_error("garbler finished early");
+	case YaoCommon::MORE:
+		output_masks = chunk->output_masks;
+		segment_received = true;
+		break;
+	}
+	gates = chunk->gates;
+	free_chunks.push(chunk);
+
+#ifdef DEBUG_YAO
+	cout << "received chunk of " << gates.size() << " bytes for gates at "
+			<< processor.PC << " in thread " << thread_num << endl;
+#endif
+}
+
+void YaoEvaluator::finish_segment()
+{
+	while (not segment_received)
+		receive_chunk();
+	segment_received = false;
+}
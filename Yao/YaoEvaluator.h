@@ -13,6 +13,14 @@
 #include "GC/Thread.h"
 #include "Tools/MMO.h"
 #include "OT/OTExtensionWithMatrix.h"
+#include "Tools/WaitQueue.h"
+
+class YaoGateChunk
+{
+public:
+	int tag;
+	ReceivedMsg gates, output_masks;
+};
 
 class YaoEvaluator: public GC::Thread<GC::Secret<YaoEvalWire>>,
 		public YaoCommon<YaoEvalWire>
@@ -27,6 +35,18 @@ protected:
 
 	YaoEvalMaster& master;
 
+	// streaming of garbled tables in continuous mode
+	RealTwoPartyPlayer* gate_player;
+	vector<YaoGateChunk> chunks;
+	WaitQueue<YaoGateChunk*> free_chunks, full_chunks;
+	thread receiver;
+	exception_ptr receive_error;
+	bool segment_received;
+
+	void receive_gates();
+	void receive_chunk();
+	void finish_segment();
+
 	friend class YaoCommon<YaoEvalWire>;
 	friend class YaoEvalWire;
 
@@ -39,20 +59,26 @@ public:
 	RealTwoPartyPlayer player;
 	OTExtensionWithMatrix ot_ext;
 
+	static const int N_CHUNKS = 4;
+
 	static YaoEvaluator& s();
 
 	YaoEvaluator(int thread_num, YaoEvalMaster& master);
+	~YaoEvaluator();
 
 	bool continuous() { return master.continuous; }
 
 	void pre_run();
 	void run(GC::Program& program);
-	void run(GC::Program& program, Player& P);
+	void run_streaming(GC::Program& program);
 	void run_from_store(GC::Program& program);
+	void post_run();
 	bool receive(Player& P);
 	void receive_to_store(Player& P);
 
+	void ensure_gates(size_t size);
 	void load_gate(YaoGate& gate);
+	char pop_output_mask();
 
 	long get_gate_id() { return gate_id(thread_num); }
 
@@ -60,11 +86,25 @@ public:
 	{ return max(1u, thread::hardware_concurrency() / master.machine.nthreads); }
 };
 
+inline void YaoEvaluator::ensure_gates(size_t size)
+{
+	while (gate_player and gates.left() < size and not segment_received)
+		receive_chunk();
+}
+
 inline void YaoEvaluator::load_gate(YaoGate& gate)
 {
+	ensure_gates(sizeof(YaoGate));
 	gates.unserialize(gate);
 }
 
+inline char YaoEvaluator::pop_output_mask()
+{
+	while (gate_player and not segment_received)
+		receive_chunk();
+	return output_masks.pop_front();
+}
+
 inline YaoEvaluator& YaoEvaluator::s()
 {
 	if (singleton)
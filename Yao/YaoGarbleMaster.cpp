@@ -15,8 +15,10 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold) :
-        super(opts), continuous(continuous), threshold(threshold)
+YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts,
+        int threshold, size_t chunk_size) :
+        super(opts), continuous(continuous), threshold(threshold),
+        chunk_size(chunk_size)
 {
     PRNG G;
     G.ReSeed();
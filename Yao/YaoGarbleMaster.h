@@ -20,8 +20,10 @@ class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
 public:
     bool continuous;
     int threshold;
+    size_t chunk_size;
 
-    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024);
+    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024,
+            size_t chunk_size = 1 << 24);
 
     GC::Thread<GC::Secret<YaoGarbleWire>>* new_thread(int i);
 
@@ -76,6 +76,7 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 	party.and_wait_timer.start();
 	party.wait(i_thread);
 	party.and_wait_timer.stop();
+	party.stream_gates();
 }
 
 void YaoGarbleWire::and_singlethread(GC::Processor<GC::Secret<YaoGarbleWire> >& processor,
@@ -93,6 +94,7 @@ void YaoGarbleWire::and_singlethread(GC::Processor<GC::Secret<YaoGarbleWire> >&
 	and_(processor.S, args, 0, n_args, total_ands, gate, counter,
 			garbler.prng, garbler.timers, repeat, garbler);
 	garbler.counter += counter - garbler.get_gate_id();
+	garbler.stream_gates();
 }
 
 void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
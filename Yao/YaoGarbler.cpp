@@ -25,13 +25,18 @@ YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 		and_main_thread_timer(CLOCK_THREAD_CPUTIME_ID),
 		player(master.N, 1, "thread" + to_string(thread_num)),
 		ot_ext(OTExtensionWithMatrix::setup(player,
-				master.get_delta().get<__m128i>(), SENDER, true))
+				master.get_delta().get<__m128i>(), SENDER, true)),
+		gate_player(0)
 {
 	prng.ReSeed();
 	set_n_program_threads(master.machine.nthreads);
 	this->init(*this);
 	if (continuous())
+	{
 	    taint();
+	    gate_player = new RealTwoPartyPlayer(master.N, 1,
+	            "gates" + to_string(thread_num));
+	}
 	else
 	{
 		processor.out.activate(false);
@@ -43,6 +48,8 @@ YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 
 YaoGarbler::~YaoGarbler()
 {
+	if (gate_player)
+		delete gate_player;
 #ifdef VERBOSE
 	cerr << "Number of AND gates: " << counter << endl;
 #endif
@@ -89,6 +96,8 @@ void YaoGarbler::post_run()
 		P->send_long(1, YaoCommon::DONE);
 		process_receiver_inputs();
 	}
+	else
+		send_gates(YaoCommon::DONE);
 }
 
 void YaoGarbler::send(Player& P)
@@ -98,6 +107,12 @@ void YaoGarbler::send(Player& P)
 			<< output_masks.size() << " output masks at " << processor.PC
 			<< " in thread " << thread_num << endl;
 #endif
+	if (gate_player)
+	{
+		send_gates(YaoCommon::MORE);
+		return;
+	}
+
 	P.send_long(1, YaoCommon::MORE);
 	size_t size = gates.size();
 	P.send_to(1, gates);
@@ -105,6 +120,26 @@ void YaoGarbler::send(Player& P)
 	P.send_to(1, output_masks);
 }
 
+void YaoGarbler::send_gates(int tag)
+{
+	octetStream header;
+	header.store(tag);
+	gate_player->send(header);
+	if (tag == YaoCommon::DONE)
+		return;
+
+	size_t size = gates.size();
+	octetStream os(gates);
+	gate_player->send(os);
+	gates.allocate(size);
+
+	if (tag == YaoCommon::MORE)
+	{
+		octetStream masks(output_masks);
+		gate_player->send(masks);
+	}
+}
+
 void YaoGarbler::process_receiver_inputs()
 {
 	while (not receiver_input_keys.empty())
@@ -49,6 +49,9 @@ public:
 	RealTwoPartyPlayer player;
 	OTExtensionWithMatrix ot_ext;
 
+	// separate channel for streaming the garbled tables
+	RealTwoPartyPlayer* gate_player;
+
 	deque<vector<Key>> receiver_input_keys;
 
 	static YaoGarbler& s();
@@ -62,6 +65,8 @@ public:
 	void run(Player& P, bool continuous);
 	void post_run();
 	void send(Player& P);
+	void send_gates(int tag);
+	void stream_gates();
 
 	void process_receiver_inputs();
 
@@ -73,6 +78,12 @@ public:
 	long get_gate_id() { return gate_id(thread_num); }
 };
 
+inline void YaoGarbler::stream_gates()
+{
+	if (gate_player and gates.size() >= master.chunk_size)
+		send_gates(YaoCommon::CHUNK);
+}
+
 inline YaoGarbler& YaoGarbler::s()
 {
 	if (singleton)
@@ -32,20 +32,34 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 			"-t", // Flag token.
 			"--threshold" // Flag token.
 	);
+	opt.add(
+			"16", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Size in MB of garbled table chunks streamed during garbling "
+			"(default: 16).", // Help description.
+			"-C", // Flag token.
+			"--chunk-size" // Flag token.
+	);
 	auto& online_opts = OnlineOptions::singleton;
 	online_opts = {opt, argc, argv, false};
 	NetworkOptionsWithNumber network_opts(opt, argc, argv, 2, false);
 	online_opts.finalize(opt, argc, argv);
 
 	int my_num = online_opts.playerno;
-	int threshold;
+	int threshold, chunk_size;
 	bool continuous = not opt.get("-O")->isSet;
 	opt.get("-t")->getInt(threshold);
+	opt.get("-C")->getInt(chunk_size);
+	if (chunk_size <= 0)
+		throw runtime_error("chunk size has to be positive");
 	progname = online_opts.progname;
 
 	GC::ThreadMasterBase* master;
 	if (my_num == 0)
-	    master = new YaoGarbleMaster(continuous, online_opts, threshold);
+	    master = new YaoGarbleMaster(continuous, online_opts, threshold,
+	            size_t(chunk_size) << 20);
 	else
 	    master = new YaoEvalMaster(continuous, online_opts);
 
@@ -1,5 +1,10 @@
 #include "Math/mfe64.h"
+#include "Math/gf2n42.h"
+#include "Math/rmfe_params.h"
 #include <random>
+#include <thread>
+#include <fstream>
+#include <sstream>
 #include "Tools/performance.h"
 
 using namespace NTL;
@@ -528,6 +533,95 @@ void test_composite_gf2_rmfe64_type1_type2(long k1, long k2) {
 //     return rmfe;
 // }
 
+void test_composite_gf2_rmfe64_lookup_tables(long k1, long k2) {
+    print_banner("test_composite_gf2_rmfe64_lookup_tables");
+    unique_ptr<Gf2RMFE> rmfe_ = get_composite_gf2_rmfe64_type1_type2(k1, k2);
+    CompositeGf2RMFE64& rmfe = dynamic_cast<CompositeGf2RMFE64&>(*rmfe_);
+    GF2XModulus mod(rmfe.ex_field_mod());
+
+    std::mt19937_64 gen(0);
+    uint64_t k_mask = (1ull << rmfe.k()) - 1, m_mask = (1ull << rmfe.m()) - 1;
+    for (int i = 0; i < 10000; i++) {
+        vec_gf2_64 a = gen() & k_mask, b = gen() & k_mask;
+        gf2x64 enc_a = rmfe.encode(a), enc_b = rmfe.encode(b);
+        gf2x64 enc_c = ntl_GF2X_to_gf2x64(MulMod(gf2x64_to_ntl_GF2X(enc_a), gf2x64_to_ntl_GF2X(enc_b), mod));
+        assert(rmfe.decode(enc_c) == (a & b));
+        assert(rmfe.decode(enc_a ^ enc_b) == (a ^ b));
+
+        gf2x64 x = gen() & m_mask;
+        assert(rmfe.tau(x) == rmfe.encode(rmfe.decode(x)));
+        assert(rmfe.tau(rmfe.tau(x)) == rmfe.tau(x));
+        assert(rmfe.decode(rmfe.random_preimage(a, gen())) == a);
+    }
+
+    int n = 1000000;
+    gf2x64 acc = 0;
+    acc_time_log("RMFE tau table (42 --> 42)");
+    for (int i = 0; i < n; i++)
+        acc ^= rmfe.tau(acc + i);
+    acc_time_log("RMFE tau table (42 --> 42)");
+    cout << "RMFE tau table (42 --> 42): " << n / (get_acc_time_log("RMFE tau table (42 --> 42)") / 1000.0 + 1e-30)
+        << " (" << acc << ")" << endl;
+}
+
+void test_gf2n42_batch() {
+    print_banner("test_gf2n42_batch");
+    GF2X mod;
+    SetCoeff(mod, 42); SetCoeff(mod, 7); SetCoeff(mod, 4); SetCoeff(mod, 3); SetCoeff(mod, 0);
+    GF2XModulus ntl_mod(mod);
+    auto ntl_mul = [&](uint64_t a, uint64_t b) {
+        return ntl_GF2X_to_gf2x64(MulMod(gf2x64_to_ntl_GF2X(a), gf2x64_to_ntl_GF2X(b), ntl_mod));
+    };
+
+    std::mt19937_64 gen(0);
+    // lengths that leave tails for every register width
+    size_t n = 0;
+    vector<uint64_t> a, b, c, u, v, res;
+    for (size_t len : {1, 3, 7, 15, 1007}) {
+        n = len;
+        for (auto x : {&a, &b, &c, &u, &v, &res})
+            x->resize(n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = gen() & gf2n42::MASK; b[i] = gen() & gf2n42::MASK; c[i] = gen() & gf2n42::MASK;
+            u[i] = gen() & gf2n42::MASK; v[i] = gen() & gf2n42::MASK;
+        }
+        a[0] = b[0] = gf2n42::MASK;
+
+        gf2n42::mul(res.data(), a.data(), b.data(), n);
+        for (size_t i = 0; i < n; i++)
+            assert(res[i] == ntl_mul(a[i], b[i]));
+        gf2n42::mul(res.data(), a.data(), b[0], n);
+        for (size_t i = 0; i < n; i++)
+            assert(res[i] == ntl_mul(a[i], b[0]));
+        gf2n42::fma2(res.data(), c.data(), a.data(), b.data(), u.data(), v.data(), n);
+        for (size_t i = 0; i < n; i++)
+            assert(res[i] == (c[i] ^ ntl_mul(a[i], b[i]) ^ ntl_mul(u[i], v[i])));
+        uint64_t dot = 0;
+        for (size_t i = 0; i < n; i++)
+            dot ^= ntl_mul(a[i], b[i]);
+        assert(gf2n42::dot(a.data(), b.data(), n) == dot);
+
+        vector<uint8_t> packed(n * gf2n42::PACKED_SIZE);
+        gf2n42::pack(packed.data(), a.data(), n);
+        for (size_t i = 0; i < n; i++)
+            for (int j = 0; j < gf2n42::PACKED_SIZE; j++)
+                assert(packed[i * gf2n42::PACKED_SIZE + j] == uint8_t(a[i] >> (8 * j)));
+        gf2n42::unpack(res.data(), packed.data(), n);
+        assert(res == a);
+        gf2n42::unpack<true>(res.data(), packed.data(), n);
+        for (size_t i = 0; i < n; i++)
+            assert(res[i] == 0);
+    }
+
+    int reps = 1000;
+    acc_time_log("GF(2^42) batch fma2");
+    for (int i = 0; i < reps; i++)
+        gf2n42::fma2(c.data(), c.data(), a.data(), b.data(), u.data(), v.data(), n);
+    acc_time_log("GF(2^42) batch fma2");
+    cout << "GF(2^42) batch fma2: " << reps * n / (get_acc_time_log("GF(2^42) batch fma2") / 1000.0 + 1e-30)
+        << " (" << c[0] << ")" << endl;
+}
+
 void benchmark_rmfe64_then_mfe64_12_48_225() {
     print_banner("test_benchmark_rmfe64_then_mfe64_12_48_225");
     auto rmfe = get_composite_gf2_rmfe64_type2(2, 6);
@@ -590,6 +684,95 @@ void benchmark_rmfe64_then_mfe64_12_48_225() {
     cout << "RMFE preimage (12 --> 48): " << n / (get_acc_time_log("RMFE preimage (12 --> 48)") / 1000.0 + 1e-30) << endl;
 }
 
+void test_rmfe_params() {
+    print_banner("test_rmfe_params");
+    auto params = RmfeParams::from<DefaultRmfeParams>();
+    assert(params.name == "2x7");
+    auto rmfe = params.new_rmfe();
+    auto mfe = params.new_mfe();
+    assert(rmfe->k() == params.k());
+    assert(rmfe->m() == params.m());
+    assert(mfe->m() == params.m());
+    assert(mfe->t() == params.t());
+
+    // products survive the RMFE, MFE and back
+    vec_GF2 a = random_vec_GF2(rmfe->k()), b = random_vec_GF2(rmfe->k());
+    vec_GF2 enc_a = mfe->encode(rmfe->encode(a)), enc_b = mfe->encode(rmfe->encode(b));
+    vec_GF2 enc_c({}, enc_a.length());
+    for (int i = 0; i < enc_a.length(); i++)
+        enc_c[i] = enc_a[i] * enc_b[i];
+    vec_GF2 c = rmfe->decode(mfe->decode(enc_c));
+    for (int i = 0; i < a.length(); i++)
+        assert(c[i] == a[i] * b[i]);
+    cout << params << endl;
+}
+
+void test_shared_rmfe_mfe() {
+    print_banner("test_shared_rmfe_mfe");
+    string cache = "/tmp/test_mfe64-cache";
+    remove((cache + "-RMFE").c_str());
+    remove((cache + "-MFE").c_str());
+    auto params = RmfeParams::from<DefaultRmfeParams>();
+    auto& rmfe = Gf2RMFE::setup_shared([&]() { return params.new_rmfe(); }, cache + "-RMFE", params.name);
+    auto& mfe = Gf2MFE::setup_shared([&]() { return params.new_mfe(); }, cache + "-MFE", params.name);
+
+    // all threads use the same frozen instances concurrently
+    vector<thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.push_back(thread([&]() {
+            assert(&Gf2RMFE::setup_shared(nullptr) == &rmfe);
+            assert(&Gf2MFE::setup_shared(nullptr) == &mfe);
+            for (int j = 0; j < 1000; j++) {
+                vec_GF2 a = random_vec_GF2(rmfe.k()), b = random_vec_GF2(rmfe.k());
+                vec_GF2 enc_a = mfe.encode(rmfe.encode(a)), enc_b = mfe.encode(rmfe.encode(b));
+                vec_GF2 enc_c({}, enc_a.length());
+                for (int k = 0; k < enc_a.length(); k++)
+                    enc_c[k] = enc_a[k] * enc_b[k];
+                vec_GF2 c = rmfe.decode(mfe.decode(enc_c));
+                for (int k = 0; k < a.length(); k++)
+                    assert(c[k] == a[k] * b[k]);
+            }
+            Gf2RMFE::reset_singleton();
+            Gf2MFE::reset_singleton();
+        }));
+    for (auto& t : threads)
+        t.join();
+
+    // fresh instances restored from the cache agree with the shared ones
+    auto rmfe2 = params.new_rmfe();
+    auto mfe2 = params.new_mfe();
+    ifstream rmfe_cache(cache + "-RMFE"), mfe_cache(cache + "-MFE");
+    string name;
+    getline(rmfe_cache, name, '\0');
+    assert(name == params.name);
+    getline(mfe_cache, name, '\0');
+    assert(name == params.name);
+    assert(rmfe2->load_tables(rmfe_cache));
+    assert(mfe2->load_tables(mfe_cache));
+    for (int i = 0; i < 1000; i++) {
+        vec_GF2 a = random_vec_GF2(rmfe.k());
+        GF2X g = rmfe.encode(a);
+        assert(rmfe2->encode(a) == g);
+        assert(mfe2->encode(g) == mfe.encode(g));
+    }
+    ifstream wrong(cache + "-MFE");
+    getline(wrong, name, '\0');
+    assert(not rmfe2->load_tables(wrong));
+
+    // tables for another modulus or other maps are rejected
+    auto check_tampered = [](auto& instance, auto fresh) {
+        stringstream saved;
+        instance.save_tables(saved);
+        string tables = saved.str();
+        // the fingerprint follows the two dimensions
+        tables.at(2 * sizeof(uint64_t)) ^= 1;
+        stringstream tampered(tables);
+        assert(not fresh->load_tables(tampered));
+    };
+    check_tampered(rmfe, params.new_rmfe());
+    check_tampered(mfe, params.new_mfe());
+}
+
 void benchmark_rmfe64_then_mfe64_14_42_195() {
     print_banner("benchmark_rmfe64_then_mfe64_14_42_195");
     auto rmfe = get_composite_gf2_rmfe64_type1_type2(2, 7);
@@ -687,6 +870,10 @@ int main() {
     test_basic_gf2_rmfe64();
     test_composite_gf2_rmfe64_type2(2, 6);
     test_composite_gf2_rmfe64_type1_type2(2, 7);
+    test_composite_gf2_rmfe64_lookup_tables(2, 7);
+    test_gf2n42_batch();
+    test_rmfe_params();
+    test_shared_rmfe_mfe();
     // test_rmfe_then_mfe();
     // test_rmfe_tau(2, 6);
     // test_basic_gf2_rmfe_type2_random_preimage();
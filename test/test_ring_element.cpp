@@ -0,0 +1,159 @@
+/*
+ * test_ring_element.cpp
+ *
+ * Compares products of Ring_Element in polynomial representation, which
+ * use the FFT where possible, with schoolbook multiplication and with
+ * a reference on plain coefficients, for m a power of two (twop == 0),
+ * with an FFT for other m (twop > 0), and without one (twop < 0).
+ */
+
+#include "FHE/Ring_Element.h"
+#include "Tools/random.h"
+
+#include <iostream>
+
+// Ring for prime m, where Phi_m = 1 + X + ... + X^(m-1) does not need NTL
+Ring prime_ring(int m)
+{
+    int phim = m - 1;
+    vector<int> pi(phim), pi_inv(m, -1), poly(phim + 1, 1);
+    for (int i = 0; i < phim; i++)
+    {
+        pi[i] = i + 1;
+        pi_inv[i + 1] = i;
+    }
+    octetStream os;
+    os.store(m);
+    os.store(phim);
+    os.store(pi);
+    os.store(pi_inv);
+    os.store(poly);
+    Ring res;
+    res.unpack(os);
+    return res;
+}
+
+// FFT_Data::init() rejects moduli without FFT, so this is assembled directly
+// with the twop that init() would have found for such a modulus
+void init_without_fft(FFT_Data& FFTD, const Ring& R, const Zp_Data& PrD)
+{
+    octetStream os;
+    R.pack(os);
+    PrD.pack(os);
+    os.store(vector<modp>());
+    os.store(vector<modp>());
+    os.store(-(1 << (numBits(R.m()) + 1)));
+    os.store(vector<modp>());
+    os.store(vector<vector<modp>>());
+    modp().pack(os);
+    os.store(vector<vector<modp>>());
+    os.store(vector<vector<modp>>());
+    FFTD.unpack(os);
+    assert(FFTD.get_twop() < 0);
+}
+
+// smallest prime above 2^100 that is 1 modulo step
+bigint find_prime(int step)
+{
+    bigint p = bigint(1) << 100;
+    p += step + 1 - p % step;
+    while (not probPrime(p))
+        p += step;
+    return p;
+}
+
+vector<bigint> reference(const vector<bigint>& a, const vector<bigint>& b,
+        const FFT_Data& FFTD)
+{
+    int n = FFTD.phi_m();
+    vector<int> phi(n + 1);
+    if (FFTD.get_twop() == 0)
+        phi[0] = phi[n] = 1;
+    else
+        phi = FFTD.Phi();
+
+    vector<bigint> prod(2 * n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            prod[i + j] += a[i] * b[j];
+    // Phi_m is monic of degree phi(m)
+    for (int i = 2 * n - 1; i >= n; i--)
+        for (int j = 0; j <= n; j++)
+            prod[i - n + j] -= prod[i] * phi[j];
+
+    prod.resize(n);
+    for (auto& x : prod)
+    {
+        x %= FFTD.get_prime();
+        if (x < 0)
+            x += FFTD.get_prime();
+    }
+    return prod;
+}
+
+void test_mul(const FFT_Data& FFTD, PRNG& G)
+{
+    int n = FFTD.phi_m();
+    vector<bigint> a(n), b(n);
+    for (int i = 0; i < n; i++)
+    {
+        G.randomBnd(a[i], FFTD.get_prime());
+        G.randomBnd(b[i], FFTD.get_prime());
+    }
+    Ring_Element x(FFTD, polynomial), y(FFTD, polynomial), z, zz;
+    x.from(a);
+    y.from(b);
+    mul(z, x, y);
+    mul_schoolbook(zz, x, y);
+    auto expected = reference(a, b, FFTD);
+
+    if (z.to_vec_bigint() != expected or zz.to_vec_bigint() != expected)
+    {
+        cout << "Error! Wrong product for m=" << FFTD.m() << ", twop="
+                << FFTD.get_twop() << endl;
+        exit(1);
+    }
+
+    // in place
+    mul(x, x, y);
+    if (x.to_vec_bigint() != expected)
+    {
+        cout << "Error! Wrong product in place for m=" << FFTD.m() << endl;
+        exit(1);
+    }
+
+    cout << "Products agree for m=" << FFTD.m() << ", twop="
+            << FFTD.get_twop() << endl;
+}
+
+int main()
+{
+    SeededPRNG G;
+
+    // twop == 0
+    for (int m : {4, 64, 1024})
+    {
+        Ring R(m);
+        Zp_Data PrD(find_prime(m));
+        FFT_Data FFTD(R, PrD);
+        assert(FFTD.get_twop() == 0);
+        test_mul(FFTD, G);
+    }
+
+    // twop > 0 and twop < 0
+    for (int m : {3, 17, 257})
+    {
+        Ring R = prime_ring(m);
+        int twop = 1 << (numBits(m) + 1);
+        Zp_Data PrD(find_prime(2 * m * twop));
+        FFT_Data FFTD(R, PrD);
+        assert(FFTD.get_twop() > 0);
+        test_mul(FFTD, G);
+
+        FFT_Data no_fft;
+        init_without_fft(no_fft, R, PrD);
+        test_mul(no_fft, G);
+    }
+
+    cout << "All good!" << endl;
+}
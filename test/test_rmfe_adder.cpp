@@ -0,0 +1,143 @@
+/*
+ * test_rmfe_adder.cpp
+ *
+ * Compares the Kogge-Stone and the ripple-carry edaBit adders
+ * on random summands, run with two parties.
+ */
+
+#include "Protocols/ProtocolSet.h"
+#include "Math/Bit.h"
+#include "Machines/Rmfe.hpp"
+#include "Tools/debug.hpp"
+#include "GC/BitAdder.h"
+
+typedef GC::RmfeShare T;
+
+// all parties know all summands, but each inputs only its own
+vector<vector<vector<T>>> input_summands(vector<vector<vector<long>>>& clear,
+        PRNG& G, T::Input& input, Player& P, int n_bits, int n_items)
+{
+    int l = T::default_length;
+    clear.clear();
+    clear.resize(n_bits, vector<vector<long>>(2, vector<long>(n_items)));
+    vector<vector<vector<T>>> res(n_bits,
+            vector<vector<T>>(2, vector<T>(n_items)));
+
+    input.reset_all(P);
+    for (int i = 0; i < n_bits; i++)
+        for (int j = 0; j < n_items; j++)
+        {
+            for (int k = 0; k < 2; k++)
+                clear[i][k][j] = G.get_uint() & ((1 << l) - 1);
+            input.add_from_all(clear[i][P.my_num()][j], l);
+        }
+    input.exchange();
+    for (int i = 0; i < n_bits; i++)
+        for (int j = 0; j < n_items; j++)
+            for (int k = 0; k < 2; k++)
+                res[i][k][j] = input.finalize(k, l);
+    return res;
+}
+
+vector<vector<long>> add(const vector<vector<vector<T>>>& summands,
+        SubProcessor<T>& proc, T::MAC_Check& output, Player& P,
+        const string& adder, int n_items)
+{
+    OnlineOptions::singleton.rmfe_adder = adder;
+    vector<vector<T>> res(n_items);
+    BitAdder().add(res, summands, 0, n_items, proc, T::default_length);
+
+    int n_bits = summands.size();
+    output.init_open(P, n_items * (n_bits + 1));
+    for (auto& x : res)
+    {
+        assert(x.size() == size_t(n_bits + 1));
+        for (auto& y : x)
+            output.prepare_open(y);
+    }
+    output.exchange(P);
+    vector<vector<long>> opened(n_items, vector<long>(n_bits + 1));
+    for (auto& x : opened)
+        for (auto& y : x)
+            y = output.finalize_open_decoded().get();
+    return opened;
+}
+
+void test_rmfe_adder(int argc, char** argv)
+{
+    // set up networking on localhost
+    int my_number = atoi(argv[1]);
+    int n_parties = atoi(argv[2]);
+    if (n_parties != 2)
+        throw runtime_error("summands are input by two parties");
+    int port_base = 9999;
+    Names N(my_number, n_parties, "localhost", port_base);
+    PlainPlayer P(N);
+
+    BinaryProtocolSetup<T> setup(P);
+    BinaryProtocolSet<T> set(P, setup);
+    auto& output = set.output;
+    auto& input = set.input;
+    SubProcessor<T> proc(output, set.prep, P);
+
+    // same summands everywhere
+    PRNG G;
+    octet seed[SEED_SIZE] = {};
+    G.SetSeed(seed);
+
+    int l = T::default_length;
+    // lengths that are not powers of two, item counts that are not
+    // multiples of the lanes per share
+    for (int n_bits : {1, 2, 3, 5, 7, 13, 32, 33})
+        for (int n_items : {1, 5, 17})
+        {
+            vector<vector<vector<long>>> clear;
+            auto summands = input_summands(clear, G, input, P, n_bits, n_items);
+            auto ripple = add(summands, proc, output, P, "ripple", n_items);
+            auto kogge_stone = add(summands, proc, output, P, "kogge-stone",
+                    n_items);
+
+            for (int j = 0; j < n_items; j++)
+                for (int k = 0; k < l; k++)
+                {
+                    unsigned long a = 0, b = 0, sum = 0, ks_sum = 0;
+                    for (int i = 0; i < n_bits; i++)
+                    {
+                        a |= ((clear[i][0][j] >> k) & 1ul) << i;
+                        b |= ((clear[i][1][j] >> k) & 1ul) << i;
+                    }
+                    for (int i = 0; i <= n_bits; i++)
+                    {
+                        sum |= ((ripple[j][i] >> k) & 1ul) << i;
+                        ks_sum |= ((kogge_stone[j][i] >> k) & 1ul) << i;
+                    }
+                    if (sum != a + b or ks_sum != a + b)
+                    {
+                        cout << "Error! " << n_bits << "-bit sum of item " << j
+                                << " in lane " << k << ": " << a << " + " << b
+                                << " gives " << sum << " (ripple) and "
+                                << ks_sum << " (Kogge-Stone)" << endl;
+                        exit(1);
+                    }
+                }
+            cout << n_bits << "-bit adders agree on " << n_items << " items"
+                    << endl;
+        }
+
+    set.check();
+    proc.check();
+    cout << "All good!" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    // need player number and number of players
+    if (argc < 3)
+    {
+        cerr << "Usage: " << argv[0]
+                << " <my number: 0/1> <total number of players: 2>" << endl;
+        exit(1);
+    }
+
+    test_rmfe_adder(argc, argv);
+}
@@ -0,0 +1,89 @@
+/*
+ * test_rmfe_mc.cpp
+ *
+ * Checks that RmfeMC accepts checked openings and that it aborts
+ * when destroyed with openings that were never checked, run with
+ * two parties.
+ */
+
+#include "Protocols/ProtocolSet.h"
+#include "Math/Bit.h"
+#include "Machines/Rmfe.hpp"
+#include "Tools/debug.hpp"
+
+#include <sys/wait.h>
+#include <signal.h>
+
+typedef GC::RmfeShare T;
+
+void open_batch(T::MAC_Check& MC, Player& P, T::mac_key_type mac_key, int n)
+{
+    MC.init_open(P, n);
+    for (int i = 0; i < n; i++)
+        MC.prepare_open(T::constant(i, P.my_num(), mac_key));
+    MC.exchange(P);
+    for (int i = 0; i < n; i++)
+        if (MC.finalize_open_decoded().get() != i)
+        {
+            cout << "Error! Wrong opening " << i << endl;
+            exit(1);
+        }
+}
+
+void test_rmfe_mc(int argc, char** argv)
+{
+    // set up networking on localhost
+    int my_number = atoi(argv[1]);
+    int n_parties = atoi(argv[2]);
+    int port_base = 9999;
+    Names N(my_number, n_parties, "localhost", port_base);
+    PlainPlayer P(N);
+
+    BinaryProtocolSetup<T> setup(P);
+    BinaryProtocolSet<T> set(P, setup);
+    auto mac_key = setup.get_mac_key();
+
+    // several batches, so that some are folded before the check
+    for (int n : {1, 10, 100})
+        open_batch(set.output, P, mac_key, n);
+    set.check();
+    cout << "Checked openings accepted" << endl;
+
+    // the parties run this in lockstep on the same connections
+    pid_t pid = fork();
+    if (pid < 0)
+        throw runtime_error("cannot fork");
+    if (pid == 0)
+    {
+        {
+            T::MAC_Check MC(mac_key);
+            open_batch(MC, P, mac_key, 10);
+            open_batch(MC, P, mac_key, 10);
+        }
+        // should not be reached
+        exit(0);
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (not WIFSIGNALED(status) or WTERMSIG(status) != SIGABRT)
+    {
+        cout << "Error! Unchecked openings did not abort" << endl;
+        exit(1);
+    }
+    cout << "Unchecked openings aborted" << endl;
+    cout << "All good!" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    // need player number and number of players
+    if (argc < 3)
+    {
+        cerr << "Usage: " << argv[0]
+                << " <my number: 0/1/...> <total number of players>" << endl;
+        exit(1);
+    }
+
+    test_rmfe_mc(argc, argv);
+}
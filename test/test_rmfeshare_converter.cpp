@@ -22,11 +22,21 @@
 
 typedef GC::RmfeShare T;
 
+typedef GC::TinierShare<gf2n_mac_key> TinierType;
+
 template<class SrcType>
 RmfeShareConverter<SrcType> setup_converter(Player& P) {
     return RmfeShareConverter<SrcType>(P);
 }
 
+// set up by RmfeBeaver for more than two parties
+template<>
+RmfeShareConverter<TinierType> setup_converter<TinierType>(Player& P) {
+    auto& thread = GC::ShareThread<TinierType::whole_type>::s();
+    return RmfeShareConverter<TinierType>(P, thread.MC->get_part_MC(),
+            dynamic_cast<TinierType::LivePrep&>(thread.DataF.get_part()));
+}
+
 template<class SrcType>
 void test_convert_to_rmfe(int argc, char** argv)
 {
@@ -139,4 +149,9 @@ int main(int argc, char** argv)
     else if (protocol == "spdz2k") {
         test_convert_to_rmfe<GC::Spdz2kBShare<DEFAULT_SECURITY>>(argc, argv);
     }
+    else if (protocol == "tinier") {
+        if (atoi(argv[2]) < 3)
+            throw runtime_error("Tinier conversion is used with more than two parties");
+        test_convert_to_rmfe<TinierType>(argc, argv);
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 
 #include "GC/RmfeMultiplier.h"
+#include "Math/gf2n42.h"
 #include "Machines/Rmfe.hpp"
 #include "Tools/debug.hpp"
 
@@ -44,6 +45,115 @@ void check_ole_result(const vector<BitMatrix>& output, const vector<BitMatrix>&
     }
 }
 
+/**
+ * Same as ``Fole::multiply()``, except that party 0 adds ``error`` to the
+ * correlation of the lowest bit of every element it sends.
+ */
+void corrupted_multiply(Fole<RmfeShare>& ole, vector<array<uint64_t, 2>>& res,
+        const vector<uint64_t>& x, const vector<array<uint64_t, 2>>& y,
+        uint64_t error)
+{
+    const int l = gf2n42::DEGREE;
+    size_t n = x.size();
+    int64_t length = n * l;
+    vector<emp::block> data(length), corr(length);
+    bool* choices = new bool[length];
+    bool me_alice = ole.player->my_num() < ole.player->other_player_num();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t y0 = y[i][0], y1 = y[i][1];
+        for (int k = 0; k < l; k++) {
+            choices[i * l + k] = (x[i] >> k) & 1;
+            uint64_t e = (k == 0 and me_alice) ? error : 0;
+            corr[i * l + k] = _mm_set_epi64x(y1, y0 ^ e);
+            y0 = gf2n42::reduce(y0 << 1, 0);
+            y1 = gf2n42::reduce(y1 << 1, 0);
+        }
+    }
+
+    res.clear();
+    res.resize(n);
+    for (bool alice_sends : {true, false}) {
+        auto channel = alice_sends ? ole.ot : ole.ot_reversed;
+        if (alice_sends == me_alice)
+            channel->send_ot_cxm_cc(data.data(), corr.data(), length);
+        else
+            channel->recv_ot_cxm_cc(data.data(), choices, length);
+        for (size_t i = 0; i < n; i++)
+            for (int k = 0; k < l; k++) {
+                res[i][0] ^= _mm_cvtsi128_si64(data[i * l + k]);
+                res[i][1] ^= _mm_extract_epi64(data[i * l + k], 1);
+            }
+    }
+    for (auto& r : res)
+        for (auto& z : r)
+            z &= gf2n42::MASK;
+    delete[] choices;
+}
+
+/**
+ * The sacrifice of ``RmfeSharePrep::buffer_silent_quintuples()`` on opened
+ * values: with c = x * b and c' = x * r, t * c - c' - (t * b - r) * x has to
+ * be zero for a random t. A wrong correlation for a choice bit of one has to
+ * make it fail. A wrong correlation for a choice bit of zero goes unnoticed,
+ * which is why the silent mode is only available with INSECURE.
+ */
+void test_corrupted_ole(Fole<RmfeShare>& ole, TwoPartyPlayer& P, PRNG& prng)
+{
+    int n = 1000;
+    vector<uint64_t> x(n);
+    vector<array<uint64_t, 2>> y(n), products;
+    for (int i = 0; i < n; i++) {
+        x[i] = prng.get_word() & gf2n42::MASK;
+        // party 1 always chooses 1 for the corrupted OT
+        if (P.my_num() == 1)
+            x[i] |= 1;
+        for (auto& z : y[i])
+            z = prng.get_word() & gf2n42::MASK;
+    }
+    corrupted_multiply(ole, products, x, y, 1);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < 2; j++)
+            products[i][j] ^= gf2n42::mul(x[i], y[i][j]);
+
+    octetStream os;
+    for (int i = 0; i < n; i++) {
+        os.store(x[i]);
+        for (int j = 0; j < 2; j++) {
+            os.store(y[i][j]);
+            os.store(products[i][j]);
+        }
+    }
+    octetStream other;
+    P.send(os);
+    P.receive(other);
+
+    // the challenge only has to be independent of the products here
+    SeededPRNG challenge_prng;
+    int n_aborts = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t x_open = x[i], y_open[2], c_open[2], tmp;
+        other.get(tmp);
+        x_open ^= tmp;
+        for (int j = 0; j < 2; j++) {
+            other.get(tmp);
+            y_open[j] = y[i][j] ^ tmp;
+            other.get(tmp);
+            c_open[j] = products[i][j] ^ tmp;
+        }
+        uint64_t t = challenge_prng.get_word() & gf2n42::MASK;
+        uint64_t rho = gf2n42::mul(t, y_open[0]) ^ y_open[1];
+        uint64_t check = gf2n42::mul(t, c_open[0]) ^ c_open[1]
+                ^ gf2n42::mul(rho, x_open);
+        if (check != 0)
+            n_aborts++;
+    }
+    if (n_aborts != n)
+        cout << "Error! Corrupted correlation passed the sacrifice "
+                << n - n_aborts << " times" << endl;
+    else
+        cout << "Corrupted correlation detected" << endl;
+}
+
 void test_silent_ole(int argc, char** argv)
 {
     // set up networking on localhost
@@ -92,6 +202,43 @@ void test_silent_ole(int argc, char** argv)
     check_ole_result(output, senderInput, keyBits, keyBits.size(), *player, ole.get_role());
     cout << "Round 2 all good!" << endl;
 
+    int n_products = 1000;
+    vector<uint64_t> x(n_products);
+    vector<array<uint64_t, 2>> y(n_products), products;
+    for (int i = 0; i < n_products; i++) {
+        x[i] = prng.get_word() & gf2n42::MASK;
+        for (auto& z : y[i])
+            z = prng.get_word() & gf2n42::MASK;
+    }
+    ole.multiply(products, x, y);
+
+    print_total_comm(P, "After OLE3");
+
+    octetStream os;
+    for (int i = 0; i < n_products; i++) {
+        os.store(x[i]);
+        for (int j = 0; j < 2; j++) {
+            os.store(y[i][j]);
+            os.store(products[i][j]);
+        }
+    }
+    player->send(os);
+    player->receive(os);
+    for (int i = 0; i < n_products; i++) {
+        uint64_t other_x, other_y, other_product;
+        os.get(other_x);
+        for (int j = 0; j < 2; j++) {
+            os.get(other_y);
+            os.get(other_product);
+            if ((products[i][j] ^ other_product) != (gf2n42::mul(x[i], other_y)
+                    ^ gf2n42::mul(other_x, y[i][j])))
+                cout << "Error!" << endl;
+        }
+    }
+    cout << "Round 3 all good!" << endl;
+
+    test_corrupted_ole(ole, *player, prng);
+
     delete player;
 }
 
@@ -0,0 +1,64 @@
+/*
+ * test_transpose.cpp
+ *
+ * Checks the transposition of 128x128 bit squares used by OT extension
+ * against the definition, and the GFNI kernel against the generic one
+ * if both the CPU and the build support it.
+ */
+
+#include "OT/BitMatrix.h"
+#include "Tools/random.h"
+#include "Tools/cpu_support.h"
+
+#include <iostream>
+
+void test_transpose(PRNG& G)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        square128 x, y;
+        x.randomize(G);
+        y = x;
+        y.transpose();
+        x.check_transpose(y);
+    }
+    cout << "Transposition agrees with the definition" << endl;
+}
+
+void test_gfni_transpose(PRNG& G)
+{
+    if (not cpu_has_gfni() or not cpu_has_avx512vbmi())
+    {
+        cout << "No GFNI or AVX-512 VBMI, skipping" << endl;
+        return;
+    }
+#if defined(__GFNI__) && defined(__AVX512VBMI__)
+    for (int i = 0; i < 1000; i++)
+    {
+        square128 x, gfni, generic;
+        x.randomize(G);
+        gfni = x;
+        generic = x;
+        gfni.gfni_transpose();
+        generic.generic_transpose();
+        if (not (gfni == generic))
+        {
+            cout << "Error! GFNI transposition differs from the generic one"
+                    << endl;
+            exit(1);
+        }
+        x.check_transpose(gfni);
+    }
+    cout << "GFNI transposition agrees with the generic one" << endl;
+#else
+    cout << "Compiled without GFNI or AVX-512 VBMI, skipping" << endl;
+#endif
+}
+
+int main()
+{
+    SeededPRNG G;
+    test_transpose(G);
+    test_gfni_transpose(G);
+    cout << "All good!" << endl;
+}